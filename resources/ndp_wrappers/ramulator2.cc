@@ -4,6 +4,7 @@
 #include "base/config.h"
 #include "base/request.h"
 #include "frontend/frontend.h"
+#include "frontend/impl/external_wrapper/batched_external.h"
 #include "memory_system/memory_system.h"
 
 namespace NDPSim {
@@ -22,6 +23,7 @@ void Ramulator2::init() {
   ramulator2_memorysystem = Ramulator::Factory::create_memory_system(config);
   ramulator2_frontend->connect_memory_system(ramulator2_memorysystem);
   ramulator2_memorysystem->connect_frontend(ramulator2_frontend);
+  ramulator2_batched = dynamic_cast<Ramulator::BatchedExternal*>(ramulator2_frontend);
   const YAML::Node& ifce_config = config["MemorySystem"]["DRAM"];
   std::string impl_name = ifce_config["impl"].as<std::string>("");
   std_name = impl_name + "-CH_" + std::to_string(memory_id);
@@ -32,7 +34,7 @@ bool Ramulator2::full() const {
 }
 
 void Ramulator2::push(mem_fetch* mf) {
-  request_queue.push(mf);
+  request_queue.push_back(mf);
 }
 
 mem_fetch* Ramulator2::return_queue_top() const {
@@ -63,26 +65,68 @@ void Ramulator2::finish() {
   num_writes = 0;
 }
 
-void Ramulator2::cycle() {
-  if (!request_queue.empty()) {
-    mem_fetch* mf = request_queue.front();
-    auto callback = [this, mf](Ramulator::Request& req) {
-      if (req.type_id == Ramulator::Request::Type::Read) {
+void Ramulator2::batched_cycle() {
+  using Ramulator::BatchedExternal;
+  constexpr size_t batch_size = 64;
+
+  // Wait for the previous cycle (which may run on its own thread) before exchanging requests
+  ramulator2_batched->sync();
+
+  BatchedExternal::Completion completions[batch_size];
+  size_t num_completions;
+  while ((num_completions = ramulator2_batched->poll(completions, batch_size)) > 0) {
+    for (size_t i = 0; i < num_completions; i++) {
+      if (completions[i].type_id == Ramulator::Request::Type::Read) {
         num_reads++;
         tot_reads++;
       } else {
         num_writes++;
         tot_writes++;
       }
+      mem_fetch* mf = static_cast<mem_fetch*>(completions[i].tag);
       mf->set_reply();
       return_queue.push(mf);
-    };
-    bool success = ramulator2_frontend->receive_external_requests(
-        mf->is_write() ? 1 : 0, mf->addr, 0, callback);
-    if(success)
-      request_queue.pop();
+    }
+  }
+
+  BatchedExternal::ExternalRequest requests[batch_size];
+  size_t num_requests = 0;
+  for (mem_fetch* mf : request_queue) {
+    if (num_requests == batch_size) {
+      break;
+    }
+    requests[num_requests++] = {(Ramulator::Addr_t) mf->addr, mf->is_write() ? 1 : 0, 0, mf};
+  }
+  size_t num_sent = ramulator2_batched->send(requests, num_requests);
+  request_queue.erase(request_queue.begin(), request_queue.begin() + num_sent);
+
+  ramulator2_batched->advance(1);
+}
+
+void Ramulator2::cycle() {
+  if (ramulator2_batched) {
+    batched_cycle();
+  } else {
+    if (!request_queue.empty()) {
+      mem_fetch* mf = request_queue.front();
+      auto callback = [this, mf](Ramulator::Request& req) {
+        if (req.type_id == Ramulator::Request::Type::Read) {
+          num_reads++;
+          tot_reads++;
+        } else {
+          num_writes++;
+          tot_writes++;
+        }
+        mf->set_reply();
+        return_queue.push(mf);
+      };
+      bool success = ramulator2_frontend->receive_external_requests(
+          mf->is_write() ? 1 : 0, mf->addr, 0, callback);
+      if(success)
+        request_queue.pop_front();
+    }
+    ramulator2_memorysystem->tick();
   }
-  ramulator2_memorysystem->tick();
   if(cycle_count % log_interval == 0) {
     if(memory_id == 0)
       spdlog::info("{}: BW utilization {}% ({} reads, {} writes)",
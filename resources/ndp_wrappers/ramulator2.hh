@@ -12,6 +12,7 @@
 namespace Ramulator {
 class IFrontEnd;
 class IMemorySystem;
+class BatchedExternal;
 }  // namespace Ramulator
 
 namespace NDPSim {
@@ -57,13 +58,17 @@ class Ramulator2 {
   //                                   unsigned &bytes) const;
 
  private:
+  void batched_cycle();
+
   bool is_gpu;
   std::string std_name;
   std::string config_path;
-  std::queue<mem_fetch *> request_queue;
+  std::deque<mem_fetch *> request_queue;
   std::queue<mem_fetch *> return_queue;
   Ramulator::IFrontEnd *ramulator2_frontend;
   Ramulator::IMemorySystem *ramulator2_memorysystem;
+  // Set if the frontend is BatchedExternal (requests and completions are then exchanged in batches)
+  Ramulator::BatchedExternal *ramulator2_batched = nullptr;
   int memory_id;
   int num_channels;
   uint64_t cycle_count = 0;
@@ -0,0 +1,127 @@
+#include <vector>
+
+#include "base/base.h"
+#include "dram/dram.h"
+#include "addr_mapper/addr_mapper.h"
+#include "memory_system/memory_system.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Maps each level of the hierarchy with physical address bit masks.
+ * @details
+ * The mapping gives, for every level, the physical address bits that form its index:
+ *
+ *   mapping:
+ *     channel: [0x2040, 0x4080]   # A list: one mask per index bit (LSB first), each bit is the XOR of the masked bits
+ *     rank: 0x200
+ *     bankgroup: 0x180            # A single mask: the masked bits are extracted as they are (i.e., pext)
+ *     bank: [0x21800, 0x43000]
+ *     row: 0x3fffc0000
+ *     column: 0x3fc00
+ *
+ * so both plain bit-slicing mappings (e.g., RoBaRaCoCh) and the XOR-based channel/bank hashing of real memory
+ * controllers can be expressed. The masks apply to the full physical address (i.e., including the transaction offset),
+ * and each level must get exactly as many index bits as it has (for the column, at the granularity of the prefetch size).
+ * Single-bit masks listed in increasing order are folded into one extraction mask, and no address bit may be extracted
+ * by more than one level. Extraction compiles to _pext_u64 when BMI2 is available (see RAMULATOR_NATIVE_ARCH).
+ */
+class BitmaskMapper final : public IAddrMapper, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IAddrMapper, BitmaskMapper, "Bitmask", "Maps the address with (XOR-hashed) bit masks.");
+
+  private:
+    struct Field {
+      uint64_t extract_mask = 0;           // Bits extracted as they are into the lower bits of the index
+      std::vector<uint64_t> xor_masks;     // Masks whose parities form the upper bits of the index
+    };
+
+    IDRAM* m_dram = nullptr;
+
+    int m_num_levels = -1;
+    std::vector<Field> m_fields;
+
+  public:
+    void init() override { };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_dram = memory_system->get_ifce<IDRAM>();
+
+      const auto& count = m_dram->m_organization.count;
+      m_num_levels = count.size();
+      m_fields.resize(m_num_levels);
+
+      YAML::Node mapping = m_config["mapping"];
+      if (!mapping.IsMap()) {
+        throw ConfigurationError("[Bitmask] Please specify the mapping of each level in \"mapping\"!");
+      }
+
+      uint64_t extracted_bits = 0;   // The bits extracted by the levels so far
+      for (int level = 0; level < m_num_levels; level++) {
+        std::string level_name(m_dram->m_levels(level));
+        int num_bits = calc_log2(count[level]);
+        // Last (Column) address have the granularity of the prefetch size
+        if (level == m_num_levels - 1) {
+          num_bits -= calc_log2(m_dram->m_internal_prefetch_size);
+        }
+
+        YAML::Node level_mapping = mapping[level_name];
+        std::vector<uint64_t> masks;
+        if (!level_mapping) {
+          if (num_bits > 0) {
+            throw ConfigurationError("[Bitmask] No mapping given for level {} ({} bits)!", level_name, num_bits);
+          }
+        } else if (level_mapping.IsSequence()) {
+          masks = level_mapping.as<std::vector<uint64_t>>();
+        } else {
+          uint64_t mask = level_mapping.as<uint64_t>();
+          for (uint64_t bit = mask & -mask; mask; mask &= mask - 1, bit = mask & -mask) {
+            masks.push_back(bit);
+          }
+        }
+
+        if (masks.size() != num_bits) {
+          throw ConfigurationError("[Bitmask] Level {} needs {} address bits but {} are mapped!", level_name, num_bits, masks.size());
+        }
+        for (auto mask : masks) {
+          if (mask == 0) {
+            throw ConfigurationError("[Bitmask] Empty mask in the mapping of level {}!", level_name);
+          }
+        }
+
+        // Fold the leading single-bit masks into the extraction mask as long as they are in increasing order
+        Field& field = m_fields[level];
+        size_t i = 0;
+        for (; i < masks.size(); i++) {
+          bool single_bit = (masks[i] & (masks[i] - 1)) == 0;
+          bool in_order = masks[i] > field.extract_mask;
+          if (!single_bit || !in_order) {
+            break;
+          }
+          field.extract_mask |= masks[i];
+        }
+        field.xor_masks.assign(masks.begin() + i, masks.end());
+
+        // An address bit can only be extracted by one level (but it can be hashed into any number of them)
+        if (field.extract_mask & extracted_bits) {
+          throw ConfigurationError("[Bitmask] Level {} extracts address bits {:#x} that are already mapped to another level!", level_name, field.extract_mask & extracted_bits);
+        }
+        extracted_bits |= field.extract_mask;
+      }
+    }
+
+    void apply(Request& req) override {
+      req.addr_vec.resize(m_num_levels, -1);
+      uint64_t addr = req.addr;
+      for (int level = 0; level < m_num_levels; level++) {
+        const Field& field = m_fields[level];
+        uint64_t index = extract_bits(addr, field.extract_mask);
+        int bit = std::popcount(field.extract_mask);
+        for (auto mask : field.xor_masks) {
+          index |= (uint64_t) parity(addr & mask) << bit++;
+        }
+        req.addr_vec[level] = index;
+      }
+    }
+};
+
+}   // namespace Ramulator
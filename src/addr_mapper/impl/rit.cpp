@@ -37,29 +37,83 @@ void LinearMapperBase_with_rit::init_rit(int num_banks, int num_rit_entries){
   m_bank_level = m_dram->m_levels("bank");
   m_row_level = m_dram->m_levels("row");
 
-  // setup RIT
-  for (int i = 0; i < num_banks; i++) {
-    std::unordered_map<int, RIT_entry> rit_bank;
-    m_row_indirection_table.push_back(rit_bank);
+  // flat bank id = sum of the (rank, ..., bank) address times the stride of each level
+  m_bank_strides.resize(m_bank_level + 1, 0);
+  int stride = 1;
+  for (int i = m_bank_level; i >= m_rank_level; i--) {
+    m_bank_strides[i] = stride;
+    stride *= m_dram->m_organization.count[i];
   }
+
+  // setup RIT: keep the load factor below 1/2 (an insertion may briefly overfill the table by a pair before the check)
+  int log2_capacity = 1;
+  while ((1 << log2_capacity) < 2 * (num_rit_entries + 2)) {
+    log2_capacity++;
+  }
+  m_rit_capacity = 1 << log2_capacity;
+  m_rit_hash_shift = 32 - log2_capacity;
+  m_row_indirection_table.assign((size_t) num_banks * m_rit_capacity, RIT_entry());
+  m_rit_sizes.assign(num_banks, 0);
+}
+
+// returns the slot of src_row in the table, or the empty slot where it would be inserted
+int LinearMapperBase_with_rit::find_rit_slot(const RIT_entry* table, int src_row) const {
+  int mask = m_rit_capacity - 1;
+  int slot = ((uint32_t) src_row * 2654435769u) >> m_rit_hash_shift;
+  while (table[slot].src_row != -1 && table[slot].src_row != src_row) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+// inserts or updates an entry
+void LinearMapperBase_with_rit::rit_set(int flat_bank_id, int src_row, int dst_row) {
+  RIT_entry* table = get_rit_bank(flat_bank_id);
+  RIT_entry& entry = table[find_rit_slot(table, src_row)];
+  if (entry.src_row == -1) {
+    m_rit_sizes[flat_bank_id]++;
+  }
+  entry.src_row = src_row;
+  entry.dst_row = dst_row;
+  entry.lock = true;
+}
+
+// removes an entry, shifting the rest of its probe sequence back so that no tombstones are needed
+void LinearMapperBase_with_rit::rit_erase(int flat_bank_id, int src_row) {
+  RIT_entry* table = get_rit_bank(flat_bank_id);
+  int mask = m_rit_capacity - 1;
+  int hole = find_rit_slot(table, src_row);
+  if (table[hole].src_row == -1) {
+    return;
+  }
+  m_rit_sizes[flat_bank_id]--;
+
+  for (int slot = (hole + 1) & mask; table[slot].src_row != -1; slot = (slot + 1) & mask) {
+    int home = ((uint32_t) table[slot].src_row * 2654435769u) >> m_rit_hash_shift;
+    // the entry can move into the hole only if the hole is between its home slot and its current slot
+    if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+      table[hole] = table[slot];
+      hole = slot;
+    }
+  }
+  table[hole] = RIT_entry();
 }
 
 // check if the entry is in the RIT
 int LinearMapperBase_with_rit::check_rit(int flat_bank_id, int src_row){
-  if (m_row_indirection_table[flat_bank_id].find(src_row) != m_row_indirection_table[flat_bank_id].end()) {
-    return m_row_indirection_table[flat_bank_id][src_row].dst_row;
-  }
-  return -1;
+  const RIT_entry* table = get_rit_bank(flat_bank_id);
+  return table[find_rit_slot(table, src_row)].dst_row;
 }
 
 // check if the RIT is full
 bool LinearMapperBase_with_rit::is_rit_full(int flat_bank_id){
-  return m_row_indirection_table[flat_bank_id].size() >= m_num_rit_entries;
+  return m_rit_sizes[flat_bank_id] >= m_num_rit_entries;
 }
 
 // check if the entry is locked
 bool LinearMapperBase_with_rit::is_rit_locked(int flat_bank_id, int src_row){
-  return m_row_indirection_table[flat_bank_id][src_row].lock;
+  const RIT_entry* table = get_rit_bank(flat_bank_id);
+  return table[find_rit_slot(table, src_row)].lock;
 }
 
 // performs the indirection if the row is in the RIT
@@ -69,11 +123,9 @@ void LinearMapperBase_with_rit::apply_indirection(Request& req){
     return;
   }
 
-  int flat_bank_id = req.addr_vec[m_bank_level];
-  int accumulated_dimension = 1;
-  for (int i = m_bank_level - 1; i >= m_rank_level; i--) {
-    accumulated_dimension *= m_dram->m_organization.count[i + 1];
-    flat_bank_id += req.addr_vec[i] * accumulated_dimension;
+  int flat_bank_id = 0;
+  for (int i = m_rank_level; i <= m_bank_level; i++) {
+    flat_bank_id += req.addr_vec[i] * m_bank_strides[i];
   }
   int src_row = req.addr_vec[m_row_level];
   int dst_row = -1;
@@ -88,27 +140,19 @@ void LinearMapperBase_with_rit::apply_indirection(Request& req){
 
 // unlocks all the entries in the RIT at the end of each Epoch
 void LinearMapperBase_with_rit::rit_unlock() {
-  for (auto& bank : m_row_indirection_table) {
-    for (auto& entry : bank) {
-      entry.second.lock = false;
-    }
+  for (auto& entry : m_row_indirection_table) {
+    entry.lock = false;
   }
 }
 
 // inserts the entry and its pair into the RIT
 void LinearMapperBase_with_rit::rit_insert_entry(int flat_bank_id, int src_row, int dst_row) {
   // insert the entry into the RIT
-  RIT_entry entry0;
-  entry0.dst_row = dst_row;
-  entry0.lock = true;
-  m_row_indirection_table[flat_bank_id][src_row] = entry0;
+  rit_set(flat_bank_id, src_row, dst_row);
   // insert the pair of entry into the RIT
-  RIT_entry entry1;
-  entry1.dst_row = src_row;
-  entry1.lock = true;
-  m_row_indirection_table[flat_bank_id][dst_row] = entry1;
+  rit_set(flat_bank_id, dst_row, src_row);
 
-  if(m_row_indirection_table[flat_bank_id].size() > m_num_rit_entries){
+  if(m_rit_sizes[flat_bank_id] > m_num_rit_entries){
     std::cerr << "RIT is full!!!!!!!!!! Check before insertion." << std::endl;
     exit(1);
   }
@@ -117,18 +161,20 @@ void LinearMapperBase_with_rit::rit_insert_entry(int flat_bank_id, int src_row,
 // removes the entry and its pair from the RIT
 void LinearMapperBase_with_rit::rit_remove_entry(int flat_bank_id, int src_row, int dst_row) {
   // remove the entry from the RIT
-  m_row_indirection_table[flat_bank_id].erase(src_row);
+  rit_erase(flat_bank_id, src_row);
   // remove the pair of entry from the RIT
-  m_row_indirection_table[flat_bank_id].erase(dst_row);
+  rit_erase(flat_bank_id, dst_row);
 }
 
-// gets a pair of entries from the RIT to unswap, the pair cannot be in the exclusion_list
-std::pair<int, int> LinearMapperBase_with_rit::get_unswap_pair(int flat_bank_id, const std::unordered_map<int, int>& exclusion_list){
+// gets a pair of entries from the RIT to unswap, neither row of the pair can be excluded
+std::pair<int, int> LinearMapperBase_with_rit::get_unswap_pair(int flat_bank_id, const std::function<bool(int)>& is_excluded){
   std::pair<int, int> unswap_pair;
-  for (auto& entry : m_row_indirection_table[flat_bank_id]) {
-    if (!entry.second.lock && exclusion_list.find(entry.first) == exclusion_list.end() && exclusion_list.find(entry.second.dst_row) == exclusion_list.end()) {
-      unswap_pair.first = entry.first;
-      unswap_pair.second = entry.second.dst_row;
+  const RIT_entry* table = get_rit_bank(flat_bank_id);
+  for (int slot = 0; slot < m_rit_capacity; slot++) {
+    const RIT_entry& entry = table[slot];
+    if (entry.src_row != -1 && !entry.lock && !is_excluded(entry.src_row) && !is_excluded(entry.dst_row)) {
+      unswap_pair.first = entry.src_row;
+      unswap_pair.second = entry.dst_row;
       return unswap_pair;
     }
   }
@@ -139,10 +185,14 @@ std::pair<int, int> LinearMapperBase_with_rit::get_unswap_pair(int flat_bank_id,
 // dumps RIT for debug
 void LinearMapperBase_with_rit::dump_rit(int flat_bank_id) {
   std::cout << "======================" << std::endl
-            << "RIT[" << flat_bank_id << "].size(): " << m_row_indirection_table[flat_bank_id].size() << std::endl;
+            << "RIT[" << flat_bank_id << "].size(): " << m_rit_sizes[flat_bank_id] << std::endl;
 
-  for (auto entry: m_row_indirection_table[flat_bank_id]){
-    std::cout << entry.first << " -> " << entry.second.dst_row << "\t" << (entry.second.lock ? "locked": "unlocked") << std::endl;
+  const RIT_entry* table = get_rit_bank(flat_bank_id);
+  for (int slot = 0; slot < m_rit_capacity; slot++) {
+    const RIT_entry& entry = table[slot];
+    if (entry.src_row != -1) {
+      std::cout << entry.src_row << " -> " << entry.dst_row << "\t" << (entry.lock ? "locked": "unlocked") << std::endl;
+    }
   }
   std::cout << "======================" << std::endl;
 }
@@ -1,5 +1,6 @@
 #include <vector>
 #include <unordered_map>
+#include <functional>
 
 #include "base/base.h"
 #include "dram/dram.h"
@@ -23,13 +24,18 @@ class LinearMapperBase_with_rit : public IAddrMapper {
     int m_bank_level = -1;
     int m_row_level = -1;
     int m_num_rit_entries = -1;
+    std::vector<int> m_bank_strides;  // Stride of each level (from rank to bank) in the flat bank id
 
     struct RIT_entry {
-      // src_row is the key of the unordered_map
-      int dst_row;
-      bool lock;
+      int src_row = -1;   // -1 if the slot is empty
+      int dst_row = -1;
+      bool lock = false;
     };
-    std::vector<std::unordered_map<int, RIT_entry>> m_row_indirection_table;
+    // One open-addressed (linear probing) table of m_rit_capacity slots per bank, all stored back to back
+    std::vector<RIT_entry> m_row_indirection_table;
+    std::vector<int> m_rit_sizes;     // Number of entries in the table of each bank
+    int m_rit_capacity = -1;          // Number of slots per bank (a power of two)
+    int m_rit_hash_shift = -1;
 
   public:
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system);
@@ -41,8 +47,14 @@ class LinearMapperBase_with_rit : public IAddrMapper {
     void rit_unlock();
     void rit_insert_entry(int flat_bank_id, int src_row, int dst_row);
     void rit_remove_entry(int flat_bank_id, int src_row, int dst_row);
-    std::pair<int, int> get_unswap_pair(int flat_bank_id, const std::unordered_map<int, int>& exclusion_list);
+    std::pair<int, int> get_unswap_pair(int flat_bank_id, const std::function<bool(int)>& is_excluded);
     void dump_rit(int flat_bank_id);
+
+  private:
+    RIT_entry* get_rit_bank(int flat_bank_id) { return &m_row_indirection_table[flat_bank_id * m_rit_capacity]; };
+    int find_rit_slot(const RIT_entry* table, int src_row) const;
+    void rit_set(int flat_bank_id, int src_row, int dst_row);
+    void rit_erase(int flat_bank_id, int src_row);
 };
 
 }   // namespace Ramulator
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef     RAMULATOR_BASE_SPSC_QUEUE_H
+#define     RAMULATOR_BASE_SPSC_QUEUE_H
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+namespace Ramulator {
+
+/**
+ * @brief    Lock-free single-producer single-consumer ring buffer
+ * @details
+ * One thread may push and one (possibly other) thread may pop concurrently. The capacity is rounded up to a power of
+ * two. The head and the tail are on separate cache lines so that the producer and the consumer do not false-share.
+ */
+template<typename T>
+class SPSCQueue {
+  private:
+    std::vector<T> m_buffer;
+    size_t m_mask;
+
+    alignas(64) std::atomic<size_t> m_head {0};    // The next slot to pop (written by the consumer)
+    alignas(64) std::atomic<size_t> m_tail {0};    // The next slot to push (written by the producer)
+
+  public:
+    explicit SPSCQueue(size_t capacity) {
+      size_t size = 1;
+      while (size < capacity) {
+        size <<= 1;
+      }
+      m_buffer.resize(size);
+      m_mask = size - 1;
+    };
+
+    size_t capacity() const { return m_mask + 1; };
+
+    /**
+     * @brief    The number of elements (exact only when called by the producer or the consumer while the other is idle)
+     */
+    size_t size() const {
+      return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    };
+
+    bool empty() const { return size() == 0; };
+
+    /**
+     * @brief    Pushes as many of the num_vals values as fit (in order) and returns how many were pushed. Producer only.
+     */
+    size_t push(const T* vals, size_t num_vals) {
+      size_t tail = m_tail.load(std::memory_order_relaxed);
+      size_t free = capacity() - (tail - m_head.load(std::memory_order_acquire));
+      size_t num_pushed = num_vals < free ? num_vals : free;
+      for (size_t i = 0; i < num_pushed; i++) {
+        m_buffer[(tail + i) & m_mask] = vals[i];
+      }
+      m_tail.store(tail + num_pushed, std::memory_order_release);
+      return num_pushed;
+    };
+
+    bool push(const T& val) { return push(&val, 1) == 1; };
+
+    /**
+     * @brief    Returns the oldest value, or nullptr if the queue is empty. Consumer only.
+     */
+    T* front() {
+      size_t head = m_head.load(std::memory_order_relaxed);
+      if (head == m_tail.load(std::memory_order_acquire)) {
+        return nullptr;
+      }
+      return &m_buffer[head & m_mask];
+    };
+
+    /**
+     * @brief    Removes the oldest value. Consumer only, and only if front() returned a value.
+     */
+    void pop() {
+      m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    };
+
+    /**
+     * @brief    Pops up to max_vals values (in order) into vals and returns how many were popped. Consumer only.
+     */
+    size_t pop(T* vals, size_t max_vals) {
+      size_t head = m_head.load(std::memory_order_relaxed);
+      size_t used = m_tail.load(std::memory_order_acquire) - head;
+      size_t num_popped = max_vals < used ? max_vals : used;
+      for (size_t i = 0; i < num_popped; i++) {
+        vals[i] = m_buffer[(head + i) & m_mask];
+      }
+      m_head.store(head + num_popped, std::memory_order_release);
+      return num_popped;
+    };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_BASE_SPSC_QUEUE_H
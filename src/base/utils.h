@@ -4,6 +4,11 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <bit>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 namespace Ramulator {
 
@@ -86,6 +91,37 @@ Integral_t slice_lower_bits(Integral_t& addr, int num_bits) {
   return lbits;
 };
 
+/**
+ * @brief Gather the bits of val selected by mask into the least significant bits (i.e., parallel bit extract).
+ * 
+ * @param val 
+ * @param mask 
+ * @return uint64_t 
+ */
+inline uint64_t extract_bits(uint64_t val, uint64_t mask) {
+#if defined(__BMI2__)
+  return _pext_u64(val, mask);
+#else
+  uint64_t bits = 0;
+  for (uint64_t bit = 1; mask; mask &= mask - 1, bit <<= 1) {
+    if (val & mask & -mask) {
+      bits |= bit;
+    }
+  }
+  return bits;
+#endif
+};
+
+/**
+ * @brief Calculate the parity (i.e., the XOR of all bits) of val
+ * 
+ * @param val 
+ * @return int 
+ */
+inline int parity(uint64_t val) {
+  return std::popcount(val) & 1;
+};
+
 
 /************************************************
  *                Tokenization
@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include <functional>
+#include <algorithm>
 
 #include "base/base.h"
 #include "dram/spec.h"
@@ -71,12 +72,88 @@ class IDRAM : public Clocked<IDRAM> {
     SpecLUT<double> m_current_vals{m_currents}; // The LUT of the values for each current constraints
     SpecDef m_cmds_counted;
 
+    std::vector<double> m_cmd_energies;          // The energy (nJ) of each counted command
+    double m_act_background_power = 0;           // The background energy (nJ) per cycle of a rank with opened rows
+    double m_pre_background_power = 0;           // The background energy (nJ) per cycle of a precharged rank
+    double m_powerdown_background_power = 0;     // The background energy (nJ) per cycle of a rank in power-down
+    double m_selfrefresh_background_power = 0;   // The background energy (nJ) per cycle of a rank in self-refresh
+
     bool m_power_debug = false;
 
     double s_total_background_energy = 0; // Total background energy consumed by the device
     double s_total_cmd_energy = 0;        // Total command energy consumed by the device
     double s_total_energy = 0;            // Total energy consumed by the device
 
+  public:
+    /**
+     * @brief     Returns the background energy (nJ) a rank has consumed so far
+     * @details
+     * The cycles the rank has spent in its current power state are counted up to the current cycle without
+     * changing the power stats, so this can be called at any time during the simulation (e.g., to sample the energy).
+     *
+     */
+    double get_rank_background_energy(const PowerStats& rank_stats) const {
+      Clk_t active_cycles = rank_stats.active_cycles;
+      Clk_t idle_cycles = rank_stats.idle_cycles;
+      Clk_t powerdown_cycles = rank_stats.powerdown_cycles;
+      Clk_t selfrefresh_cycles = rank_stats.selfrefresh_cycles;
+
+      switch (rank_stats.cur_power_state) {
+        case PowerStats::PowerState::ACTIVE:
+          active_cycles += m_clk - rank_stats.active_start_cycle;
+          break;
+        case PowerStats::PowerState::IDLE:
+          idle_cycles += m_clk - rank_stats.idle_start_cycle;
+          break;
+        case PowerStats::PowerState::POWER_DOWN:
+          powerdown_cycles += m_clk - rank_stats.lowpower_start_cycle;
+          break;
+        case PowerStats::PowerState::SELF_REFRESH:
+          selfrefresh_cycles += m_clk - rank_stats.lowpower_start_cycle;
+          break;
+        default:
+          // The background energy during a refresh is part of the refresh command energy
+          break;
+      }
+
+      return m_act_background_power * active_cycles + m_pre_background_power * idle_cycles +
+             m_powerdown_background_power * powerdown_cycles + m_selfrefresh_background_power * selfrefresh_cycles;
+    }
+
+    /**
+     * @brief     Returns the command energy (nJ) a rank has consumed so far
+     *
+     */
+    double get_rank_cmd_energy(const PowerStats& rank_stats) const {
+      double cmd_energy = 0;
+      for (int i = 0; i < m_cmd_energies.size(); i++) {
+        cmd_energy += m_cmd_energies[i] * rank_stats.cmd_counters[i];
+      }
+      return cmd_energy;
+    }
+
+    /**
+     * @brief     Computes the energy breakdown of a rank whose power stats have been finalized and adds it to the totals
+     *
+     */
+    void accumulate_rank_energy(PowerStats& rank_stats) {
+      rank_stats.act_background_energy = m_act_background_power * rank_stats.active_cycles;
+      rank_stats.pre_background_energy = m_pre_background_power * rank_stats.idle_cycles;
+      rank_stats.powerdown_background_energy = m_powerdown_background_power * rank_stats.powerdown_cycles;
+      rank_stats.selfrefresh_background_energy = m_selfrefresh_background_power * rank_stats.selfrefresh_cycles;
+
+      rank_stats.total_background_energy = rank_stats.act_background_energy
+                                            + rank_stats.pre_background_energy
+                                            + rank_stats.powerdown_background_energy
+                                            + rank_stats.selfrefresh_background_energy;
+      rank_stats.total_cmd_energy = get_rank_cmd_energy(rank_stats);
+      rank_stats.total_energy = rank_stats.total_background_energy + rank_stats.total_cmd_energy;
+
+      s_total_background_energy += rank_stats.total_background_energy;
+      s_total_cmd_energy += rank_stats.total_cmd_energy;
+      s_total_energy += rank_stats.total_energy;
+    }
+
   /************************************************
    *          Device Behavior Interface
    ***********************************************/   
@@ -126,6 +203,15 @@ class IDRAM : public Clocked<IDRAM> {
      */
     virtual bool check_rowbuffer_open(int command, const AddrVec_t& addr_vec) = 0;
 
+    /**
+     * @brief     Checks whether the node targeted by the command has an opened row
+     * @details
+     * Given a command and its address, this function should return whether the (bank-ish) node
+     * that the command targets currently has an opened row, i.e., a miss would be a row conflict.
+     * 
+     */
+    virtual bool check_node_open(int command, const AddrVec_t& addr_vec) = 0;
+
     /**
      * @brief     An universal interface for the host to change DRAM configurations on the fly
      * @details
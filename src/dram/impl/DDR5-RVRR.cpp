@@ -360,6 +360,11 @@ class DDR5RVRR : public IDRAM, public Implementation {
       return m_channels[channel_id]->check_node_open(command, addr_vec, m_clk);
     };
 
+    bool check_rowbuffer_open(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->check_rowbuffer_open(command, addr_vec, m_clk);
+    };
+
   private:
     void set_organization() {
       // Channel width
@@ -772,6 +777,8 @@ class DDR5RVRR : public IDRAM, public Implementation {
         }
       }
 
+      set_energies();
+
       m_power_debug = param<bool>("power_debug").default_val(false);
 
       // TODO: Check for multichannel configs.
@@ -860,10 +867,7 @@ class DDR5RVRR : public IDRAM, public Implementation {
       }
     }
 
-    void process_rank_energy(PowerStats& rank_stats, Node* rank_node) {
-      
-      Lambdas::Power::Rank::finalize_rank<DDR5RVRR>(rank_node, 0, AddrVec_t(), m_clk);
-
+    void set_energies() {
       size_t num_bankgroups = m_organization.count[m_levels["bankgroup"]];
 
       auto TS = [&](std::string_view timing) { return m_timing_vals(timing); };
@@ -872,65 +876,54 @@ class DDR5RVRR : public IDRAM, public Implementation {
 
       double tCK_ns = (double) TS("tCK_ps") / 1000.0;
 
-      rank_stats.act_background_energy = (VE("VDD") * CE("IDD3N") + VE("VPP") * CE("IPP3N")) 
-                                            * rank_stats.active_cycles * tCK_ns / 1E3;
-
-      rank_stats.pre_background_energy = (VE("VDD") * CE("IDD2N") + VE("VPP") * CE("IPP2N")) 
-                                            * rank_stats.idle_cycles * tCK_ns / 1E3;
+      m_act_background_power = (VE("VDD") * CE("IDD3N") + VE("VPP") * CE("IPP3N")) * tCK_ns / 1E3;
+      m_pre_background_power = (VE("VDD") * CE("IDD2N") + VE("VPP") * CE("IPP2N")) * tCK_ns / 1E3;
 
+      m_cmd_energies.resize(m_cmds_counted.size(), 0);
 
-      double act_cmd_energy  = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("ACT")] * TS("nRAS") * tCK_ns / 1E3;
+      m_cmd_energies[m_cmds_counted("ACT")] = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) 
+                                      * TS("nRAS") * tCK_ns / 1E3;
 
-      double pre_cmd_energy  = (VE("VDD") * (CE("IDD0") - CE("IDD2N")) + VE("VPP") * (CE("IPP0") - CE("IPP2N"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("PRE")] * TS("nRP")  * tCK_ns / 1E3;
+      m_cmd_energies[m_cmds_counted("PRE")] = (VE("VDD") * (CE("IDD0") - CE("IDD2N")) + VE("VPP") * (CE("IPP0") - CE("IPP2N"))) 
+                                      * TS("nRP")  * tCK_ns / 1E3;
 
-      double rd_cmd_energy   = (VE("VDD") * (CE("IDD4R") - CE("IDD3N")) + VE("VPP") * (CE("IPP4R") - CE("IPP3N"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("RD")] * TS("nBL") * tCK_ns / 1E3;
+      m_cmd_energies[m_cmds_counted("RD")] = (VE("VDD") * (CE("IDD4R") - CE("IDD3N")) + VE("VPP") * (CE("IPP4R") - CE("IPP3N"))) 
+                                      * TS("nBL") * tCK_ns / 1E3;
 
-      double wr_cmd_energy   = (VE("VDD") * (CE("IDD4W") - CE("IDD3N")) + VE("VPP") * (CE("IPP4W") - CE("IPP3N"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("WR")] * TS("nBL") * tCK_ns / 1E3;
+      m_cmd_energies[m_cmds_counted("WR")] = (VE("VDD") * (CE("IDD4W") - CE("IDD3N")) + VE("VPP") * (CE("IPP4W") - CE("IPP3N"))) 
+                                      * TS("nBL") * tCK_ns / 1E3;
 
-      double ref_cmd_energy  = (VE("VDD") * (CE("IDD5B")) + VE("VPP") * (CE("IPP5B"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("REF")] * TS("nRFC1") * tCK_ns / 1E3;
+      m_cmd_energies[m_cmds_counted("REF")] = (VE("VDD") * (CE("IDD5B")) + VE("VPP") * (CE("IPP5B"))) 
+                                      * TS("nRFC1") * tCK_ns / 1E3;
 
-      double rfm_cmd_energy = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) * num_bankgroups
-                                      * rank_stats.cmd_counters[m_cmds_counted("RFM")] * TS("nRFMsb") * tCK_ns / 1E3;
+      m_cmd_energies[m_cmds_counted("RFM")] = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) * num_bankgroups
+                                      * TS("nRFMsb") * tCK_ns / 1E3;
 
-      double rrfm_cmd_energy = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) * num_bankgroups
-                                      * rank_stats.cmd_counters[m_cmds_counted("RRFM")] * TS("nRRFMsb") * tCK_ns / 1E3;
+      m_cmd_energies[m_cmds_counted("RRFM")] = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) * num_bankgroups
+                                      * TS("nRRFMsb") * tCK_ns / 1E3;
 
-      double vrr_cmd_energy  = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("VRR")] * TS("nVRR") * tCK_ns / 1E3;
+      m_cmd_energies[m_cmds_counted("VRR")] = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) 
+                                      * TS("nVRR") * tCK_ns / 1E3;
 
-      double rvrr_cmd_energy  = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0")  - CE("IPP3N"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("RVRR")] * TS("nRVRR") * tCK_ns / 1E3;
+      m_cmd_energies[m_cmds_counted("RVRR")] = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0")  - CE("IPP3N"))) 
+                                      * TS("nRVRR") * tCK_ns / 1E3;
+    }
 
-      rank_stats.total_background_energy = rank_stats.act_background_energy + rank_stats.pre_background_energy;
-      rank_stats.total_cmd_energy = act_cmd_energy 
-                                    + pre_cmd_energy 
-                                    + rd_cmd_energy
-                                    + wr_cmd_energy 
-                                    + ref_cmd_energy
-                                    + rfm_cmd_energy
-                                    + rrfm_cmd_energy
-                                    + vrr_cmd_energy
-                                    + rvrr_cmd_energy;
+    void process_rank_energy(PowerStats& rank_stats, Node* rank_node) {
+      
+      Lambdas::Power::Rank::finalize_rank<DDR5RVRR>(rank_node, 0, AddrVec_t(), m_clk);
 
-      rank_stats.total_energy = rank_stats.total_background_energy + rank_stats.total_cmd_energy;
+      accumulate_rank_energy(rank_stats);
 
-      s_total_background_energy += rank_stats.total_background_energy;
-      s_total_cmd_energy += rank_stats.total_cmd_energy;
-      s_total_energy += rank_stats.total_energy;
-      s_total_rfm_energy += rfm_cmd_energy;
-      s_total_rrfm_energy += rrfm_cmd_energy;
-      s_total_vrr_energy += vrr_cmd_energy;
-      s_total_rvrr_energy += rvrr_cmd_energy;
+      s_total_rfm_energy += m_cmd_energies[m_cmds_counted("RFM")] * rank_stats.cmd_counters[m_cmds_counted("RFM")];
+      s_total_rrfm_energy += m_cmd_energies[m_cmds_counted("RRFM")] * rank_stats.cmd_counters[m_cmds_counted("RRFM")];
+      s_total_vrr_energy += m_cmd_energies[m_cmds_counted("VRR")] * rank_stats.cmd_counters[m_cmds_counted("VRR")];
+      s_total_rvrr_energy += m_cmd_energies[m_cmds_counted("RVRR")] * rank_stats.cmd_counters[m_cmds_counted("RVRR")];
 
-      s_total_rfm_cycles[rank_stats.rank_id] = rank_stats.cmd_counters[m_cmds_counted("RFM")] * TS("nRFMsb");
-      s_total_rrfm_cycles[rank_stats.rank_id] = rank_stats.cmd_counters[m_cmds_counted("RRFM")] * TS("nRRFMsb");
-      s_total_vrr_cycles[rank_stats.rank_id] = rank_stats.cmd_counters[m_cmds_counted("VRR")] * TS("nVRR");
-      s_total_rvrr_cycles[rank_stats.rank_id] = rank_stats.cmd_counters[m_cmds_counted("RVRR")] * TS("nRVRR");
+      s_total_rfm_cycles[rank_stats.rank_id] = rank_stats.cmd_counters[m_cmds_counted("RFM")] * m_timing_vals("nRFMsb");
+      s_total_rrfm_cycles[rank_stats.rank_id] = rank_stats.cmd_counters[m_cmds_counted("RRFM")] * m_timing_vals("nRRFMsb");
+      s_total_vrr_cycles[rank_stats.rank_id] = rank_stats.cmd_counters[m_cmds_counted("VRR")] * m_timing_vals("nVRR");
+      s_total_rvrr_cycles[rank_stats.rank_id] = rank_stats.cmd_counters[m_cmds_counted("RVRR")] * m_timing_vals("nRVRR");
     }
 };
 
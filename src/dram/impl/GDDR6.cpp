@@ -26,6 +26,17 @@ class GDDR6 : public IDRAM, public Implementation {
       {"GDDR6_2000_1250mV_quad",   {2000,  4,  24,    30,     19,  30,   60,   89,   30,   4,   6,   4,    6,   11,   11,   9,    11,   42,   210,  105,   21,   3333,   570}},
     };
 
+    // Nominal supply voltages of JESD250 (GDDR6)
+    inline static const std::map<std::string, std::vector<double>> voltage_presets = {
+      //   name          VDD      VPP
+      {"Default",       {1.35,    1.8}},
+      {"1250mV",        {1.25,    1.8}},
+    };
+
+    // Currents (mA) are per channel. They depend on the vendor and part, so there is no preset and each of them
+    // must be given in the config (e.g., current: {IDD0: ..., ...}).
+    inline static const std::map<std::string, std::vector<double>> current_presets = {};
+
 
   /************************************************
    *                Organization
@@ -44,12 +55,12 @@ class GDDR6 : public IDRAM, public Implementation {
       "ACT", 
       "PREA", "PRE",
       "RD",  "WR",  "RDA",  "WRA",
-      "REFab", "REFpb", "REFp2b",
+      "REFab", "REFab_end", "REFpb", "REFp2b",
     };
 
     inline static const ImplLUT m_command_scopes = LUT (
       m_commands, m_levels, {
-        {"REFab", "channel"},  {"REFp2b",  "channel"},
+        {"REFab", "channel"}, {"REFab_end", "channel"},  {"REFp2b",  "channel"},
         {"ACT",   "row"},
         {"PREA", "bank"},   {"PRE",  "bank"},  {"REFpb", "bank"},
         {"RD",    "column"}, {"WR",   "column"},  {"RDA",  "column"}, {"WRA",   "column"},
@@ -67,6 +78,7 @@ class GDDR6 : public IDRAM, public Implementation {
         {"RDA",   {false,  true,    true,    false}},
         {"WRA",   {false,  true,    true,    false}},
         {"REFab", {false,  false,   false,   true }}, //double check
+        {"REFab_end", {false,  true,    false,   false}},
         {"REFpb", {false,  false,   false,   true }},
         {"REFp2b",{false,  false,   false,   true }},
       }
@@ -99,6 +111,23 @@ class GDDR6 : public IDRAM, public Implementation {
     };
 
 
+  /************************************************
+   *                   Power
+   ***********************************************/
+    inline static constexpr ImplDef m_voltages = {
+      "VDD", "VPP"
+    };
+    
+    inline static constexpr ImplDef m_currents = {
+      "IDD0", "IDD2N", "IDD3N", "IDD4R", "IDD4W", "IDD5B",
+      "IPP0", "IPP2N", "IPP3N", "IPP4R", "IPP4W", "IPP5B"
+    };
+
+    inline static constexpr ImplDef m_cmds_counted = {
+      "ACT", "PRE", "RD", "WR", "REF", "REFpb"
+    };
+
+
   /************************************************
    *                 Node States
    ***********************************************/
@@ -126,11 +155,21 @@ class GDDR6 : public IDRAM, public Implementation {
     FuncMatrix<PreqFunc_t<Node>>    m_preqs;
     FuncMatrix<RowhitFunc_t<Node>>  m_rowhits;
     FuncMatrix<RowopenFunc_t<Node>> m_rowopens;
+    FuncMatrix<PowerFunc_t<Node>>   m_powers;
 
 
   public:
     void tick() override {
       m_clk++;
+
+      // Check if there is any future action at this cycle
+      for (int i = m_future_actions.size() - 1; i >= 0; i--) {
+        auto& future_action = m_future_actions[i];
+        if (future_action.clk == m_clk) {
+          handle_future_action(future_action.cmd, future_action.addr_vec);
+          m_future_actions.erase(m_future_actions.begin() + i);
+        }
+      }
     };
 
     void init() override {
@@ -142,6 +181,7 @@ class GDDR6 : public IDRAM, public Implementation {
       set_preqs();
       set_rowhits();
       set_rowopens();
+      set_powers();
       
       create_nodes();
     };
@@ -149,7 +189,36 @@ class GDDR6 : public IDRAM, public Implementation {
     void issue_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       m_channels[channel_id]->update_timing(command, addr_vec, m_clk);
+      m_channels[channel_id]->update_powers(command, addr_vec, m_clk);
       m_channels[channel_id]->update_states(command, addr_vec, m_clk);
+
+      // Check if the command requires future action
+      check_future_action(command, addr_vec);
+    };
+
+    void check_future_action(int command, const AddrVec_t& addr_vec) {
+      switch (command) {
+        case m_commands("REFab"):
+          // REFab command requires future action after nRFC cycles
+          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFC") - 1});
+          break;
+        default:
+          // Other commands do not require future actions
+          break;
+      }
+    }
+
+    void handle_future_action(int command, const AddrVec_t& addr_vec) {
+      int channel_id = addr_vec[m_levels["channel"]];
+      switch (command) {
+        case m_commands("REFab"):
+          m_channels[channel_id]->update_powers(m_commands("REFab_end"), addr_vec, m_clk);
+          m_channels[channel_id]->update_states(m_commands("REFab_end"), addr_vec, m_clk);
+          break;
+        default:
+          // Other commands do not require future actions
+          break;
+      }
     };
 
     int get_preq_command(int command, const AddrVec_t& addr_vec) override {
@@ -466,6 +535,35 @@ class GDDR6 : public IDRAM, public Implementation {
       m_rowopens[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowOpen::Bank::RDWR<GDDR6>;
     }
 
+    void set_powers() {
+      m_drampower_enable = param<bool>("drampower_enable").default_val(false);
+
+      if (!m_drampower_enable)
+        return;
+
+      Lambdas::Power::Rails::setup<GDDR6>(this, "nRP", "nBL", "nRFC");
+
+      m_powers.resize(m_levels.size(), std::vector<PowerFunc_t<Node>>(m_commands.size()));
+
+      m_powers[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Power::Bank::ACT<GDDR6>;
+      m_powers[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Power::Bank::PRE<GDDR6>;
+      m_powers[m_levels["bank"]][m_commands["RD"]]  = Lambdas::Power::Bank::RD<GDDR6>;
+      m_powers[m_levels["bank"]][m_commands["WR"]]  = Lambdas::Power::Bank::WR<GDDR6>;
+      m_powers[m_levels["bank"]][m_commands["RDA"]] = Lambdas::Power::Bank::RDA<GDDR6>;
+      m_powers[m_levels["bank"]][m_commands["WRA"]] = Lambdas::Power::Bank::WRA<GDDR6>;
+      m_powers[m_levels["bank"]][m_commands["REFpb"]] = Lambdas::Power::Bank::REFpb<GDDR6>;
+      m_powers[m_levels["channel"]][m_commands["REFp2b"]] = Lambdas::Power::Bank::REFpb<GDDR6, 2>;
+
+      // GDDR6 has no ranks: the power state is kept per channel
+      m_powers[m_levels["channel"]][m_commands["ACT"]]   = Lambdas::Power::Rank::ACT<GDDR6>;
+      m_powers[m_levels["channel"]][m_commands["PRE"]]   = Lambdas::Power::Rank::PRE<GDDR6>;
+      m_powers[m_levels["channel"]][m_commands["RDA"]]   = Lambdas::Power::Rank::PRE<GDDR6>;
+      m_powers[m_levels["channel"]][m_commands["WRA"]]   = Lambdas::Power::Rank::PRE<GDDR6>;
+      m_powers[m_levels["channel"]][m_commands["PREA"]]  = Lambdas::Power::Rank::PREA<GDDR6>;
+      m_powers[m_levels["channel"]][m_commands["REFab"]] = Lambdas::Power::Rank::REFab<GDDR6>;
+      m_powers[m_levels["channel"]][m_commands["REFab_end"]] = Lambdas::Power::Rank::REFab_end<GDDR6>;
+    }
+
 
     void create_nodes() {
       int num_channels = m_organization.count[m_levels["channel"]];
@@ -474,6 +572,13 @@ class GDDR6 : public IDRAM, public Implementation {
         m_channels.push_back(channel);
       }
     };
+
+    void finalize() override {
+      if (!m_drampower_enable)
+        return;
+
+      Lambdas::Power::Rails::finalize<GDDR6>(this, m_clk);
+    }
 };
 
 
@@ -97,7 +97,7 @@ class HBM2_64B : public IDRAM, public Implementation {
    *                 Node States
    ***********************************************/
     inline static constexpr ImplDef m_states = {
-       "Opened", "Closed", "N/A"
+       "Opened", "Closed", "N/A", "Refreshing"
     };
 
     inline static const ImplLUT m_init_states = LUT (
@@ -167,6 +167,11 @@ class HBM2_64B : public IDRAM, public Implementation {
       return m_channels[channel_id]->check_rowbuffer_open(command, addr_vec, m_clk);
     };
 
+    bool check_node_open(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->check_node_open(command, addr_vec, m_clk);
+    };
+
   private:
     void set_organization() {
       // Channel width
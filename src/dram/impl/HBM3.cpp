@@ -20,6 +20,16 @@ class HBM3 : public IDRAM, public Implementation {
       // TODO: Find more sources on HBM3 timings...
     };
 
+    // Nominal supply voltages of JESD238 (HBM3)
+    inline static const std::map<std::string, std::vector<double>> voltage_presets = {
+      //   name          VDD      VPP
+      {"Default",       {1.1,     1.8}},
+    };
+
+    // Currents (mA) are per channel. They depend on the vendor and part, so there is no preset and each of them
+    // must be given in the config (e.g., current: {IDD0: ..., ...}).
+    inline static const std::map<std::string, std::vector<double>> current_presets = {};
+
 
   /************************************************
    *                Organization
@@ -38,7 +48,7 @@ class HBM3 : public IDRAM, public Implementation {
       "ACT", 
       "PRE", "PREA",
       "RD",  "WR",  "RDA",  "WRA",
-      "REFab", "REFsb",
+      "REFab", "REFab_end", "REFsb",
       "RFMab", "RFMsb"
     };
 
@@ -47,7 +57,7 @@ class HBM3 : public IDRAM, public Implementation {
         {"ACT",   "row"},
         {"PRE",   "bank"},    {"PREA",   "channel"},
         {"RD",    "column"},  {"WR",     "column"}, {"RDA",   "column"}, {"WRA",   "column"},
-        {"REFab", "channel"}, {"REFsb",  "bank"},
+        {"REFab", "channel"}, {"REFab_end", "channel"}, {"REFsb",  "bank"},
         {"RFMab", "channel"}, {"RFMsb",  "bank"},
       }
     );
@@ -63,6 +73,7 @@ class HBM3 : public IDRAM, public Implementation {
         {"RDA",   {false,  true,    true,    false}},
         {"WRA",   {false,  true,    true,    false}},
         {"REFab", {false,  false,   false,   true }},
+        {"REFab_end", {false,  true,    false,   false}},
         {"REFsb", {false,  false,   false,   true }},
         {"RFMab", {false,  false,   false,   true }},
         {"RFMsb", {false,  false,   false,   true }},
@@ -97,6 +108,23 @@ class HBM3 : public IDRAM, public Implementation {
     };
 
 
+  /************************************************
+   *                   Power
+   ***********************************************/
+    inline static constexpr ImplDef m_voltages = {
+      "VDD", "VPP"
+    };
+    
+    inline static constexpr ImplDef m_currents = {
+      "IDD0", "IDD2N", "IDD3N", "IDD4R", "IDD4W", "IDD5B",
+      "IPP0", "IPP2N", "IPP3N", "IPP4R", "IPP4W", "IPP5B"
+    };
+
+    inline static constexpr ImplDef m_cmds_counted = {
+      "ACT", "PRE", "RD", "WR", "REF", "REFpb"
+    };
+
+
   /************************************************
    *                 Node States
    ***********************************************/
@@ -125,11 +153,21 @@ class HBM3 : public IDRAM, public Implementation {
     FuncMatrix<PreqFunc_t<Node>>    m_preqs;
     FuncMatrix<RowhitFunc_t<Node>>  m_rowhits;
     FuncMatrix<RowopenFunc_t<Node>> m_rowopens;
+    FuncMatrix<PowerFunc_t<Node>>   m_powers;
 
 
   public:
     void tick() override {
       m_clk++;
+
+      // Check if there is any future action at this cycle
+      for (int i = m_future_actions.size() - 1; i >= 0; i--) {
+        auto& future_action = m_future_actions[i];
+        if (future_action.clk == m_clk) {
+          handle_future_action(future_action.cmd, future_action.addr_vec);
+          m_future_actions.erase(m_future_actions.begin() + i);
+        }
+      }
     };
 
     void init() override {
@@ -141,6 +179,7 @@ class HBM3 : public IDRAM, public Implementation {
       set_preqs();
       set_rowhits();
       set_rowopens();
+      set_powers();
       
       create_nodes();
     };
@@ -148,7 +187,36 @@ class HBM3 : public IDRAM, public Implementation {
     void issue_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       m_channels[channel_id]->update_timing(command, addr_vec, m_clk);
+      m_channels[channel_id]->update_powers(command, addr_vec, m_clk);
       m_channels[channel_id]->update_states(command, addr_vec, m_clk);
+
+      // Check if the command requires future action
+      check_future_action(command, addr_vec);
+    };
+
+    void check_future_action(int command, const AddrVec_t& addr_vec) {
+      switch (command) {
+        case m_commands("REFab"):
+          // REFab command requires future action after nRFC cycles
+          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFC") - 1});
+          break;
+        default:
+          // Other commands do not require future actions
+          break;
+      }
+    }
+
+    void handle_future_action(int command, const AddrVec_t& addr_vec) {
+      int channel_id = addr_vec[m_levels["channel"]];
+      switch (command) {
+        case m_commands("REFab"):
+          m_channels[channel_id]->update_powers(m_commands("REFab_end"), addr_vec, m_clk);
+          m_channels[channel_id]->update_states(m_commands("REFab_end"), addr_vec, m_clk);
+          break;
+        default:
+          // Other commands do not require future actions
+          break;
+      }
     };
 
     int get_preq_command(int command, const AddrVec_t& addr_vec) override {
@@ -419,6 +487,34 @@ class HBM3 : public IDRAM, public Implementation {
       m_rowopens[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowOpen::Bank::RDWR<HBM3>;
     }
 
+    void set_powers() {
+      m_drampower_enable = param<bool>("drampower_enable").default_val(false);
+
+      if (!m_drampower_enable)
+        return;
+
+      Lambdas::Power::Rails::setup<HBM3>(this, "nRP", "nBL", "nRFC");
+
+      m_powers.resize(m_levels.size(), std::vector<PowerFunc_t<Node>>(m_commands.size()));
+
+      m_powers[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Power::Bank::ACT<HBM3>;
+      m_powers[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Power::Bank::PRE<HBM3>;
+      m_powers[m_levels["bank"]][m_commands["RD"]]  = Lambdas::Power::Bank::RD<HBM3>;
+      m_powers[m_levels["bank"]][m_commands["WR"]]  = Lambdas::Power::Bank::WR<HBM3>;
+      m_powers[m_levels["bank"]][m_commands["RDA"]] = Lambdas::Power::Bank::RDA<HBM3>;
+      m_powers[m_levels["bank"]][m_commands["WRA"]] = Lambdas::Power::Bank::WRA<HBM3>;
+      m_powers[m_levels["bank"]][m_commands["REFsb"]] = Lambdas::Power::Bank::REFpb<HBM3>;
+
+      // HBM3 has no ranks: the power state is kept per channel
+      m_powers[m_levels["channel"]][m_commands["ACT"]]   = Lambdas::Power::Rank::ACT<HBM3>;
+      m_powers[m_levels["channel"]][m_commands["PRE"]]   = Lambdas::Power::Rank::PRE<HBM3>;
+      m_powers[m_levels["channel"]][m_commands["RDA"]]   = Lambdas::Power::Rank::PRE<HBM3>;
+      m_powers[m_levels["channel"]][m_commands["WRA"]]   = Lambdas::Power::Rank::PRE<HBM3>;
+      m_powers[m_levels["channel"]][m_commands["PREA"]]  = Lambdas::Power::Rank::PREA<HBM3>;
+      m_powers[m_levels["channel"]][m_commands["REFab"]] = Lambdas::Power::Rank::REFab<HBM3>;
+      m_powers[m_levels["channel"]][m_commands["REFab_end"]] = Lambdas::Power::Rank::REFab_end<HBM3>;
+    }
+
 
     void create_nodes() {
       int num_channels = m_organization.count[m_levels["channel"]];
@@ -427,6 +523,13 @@ class HBM3 : public IDRAM, public Implementation {
         m_channels.push_back(channel);
       }
     };
+
+    void finalize() override {
+      if (!m_drampower_enable)
+        return;
+
+      Lambdas::Power::Rails::finalize<HBM3>(this, m_clk);
+    }
 };
 
 
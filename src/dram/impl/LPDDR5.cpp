@@ -22,6 +22,16 @@ class LPDDR5 : public IDRAM, public Implementation {
       // {"LPDDR5X_8500",  {8500,  2,   20,   15,    17,   15,     34,   30,   28,   4,  11,   2,   4,   5,    10,   16,  2,   -1,      -1,   -1,   -1,        -1,    2,   1250}},
     };
 
+    // Nominal supply voltages of JESD209-5 (LPDDR5)
+    inline static const std::map<std::string, std::vector<double>> voltage_presets = {
+      //   name          VDD1     VDD2H
+      {"Default",       {1.8,     1.05}},
+    };
+
+    // Currents (mA) are per rank. They depend on the vendor and part, so there is no preset and each of them
+    // must be given in the config (e.g., current: {IDD01: ..., ...}). The VDD2L and VDDQ rails are not modeled.
+    inline static const std::map<std::string, std::vector<double>> current_presets = {};
+
 
   /************************************************
    *                Organization
@@ -41,7 +51,7 @@ class LPDDR5 : public IDRAM, public Implementation {
       "PRE",    "PREA",
       "CASRD",  "CASWR",   // WCK2CK Sync
       "RD16",   "WR16",   "RD16A",   "WR16A",
-      "REFab",  "REFpb",
+      "REFab", "REFab_end",  "REFpb",
       "RFMab",  "RFMpb",
     };
 
@@ -51,7 +61,7 @@ class LPDDR5 : public IDRAM, public Implementation {
         {"PRE",   "bank"},   {"PREA",   "rank"},
         {"CASRD", "rank"},   {"CASWR",  "rank"},
         {"RD16",  "column"}, {"WR16",   "column"}, {"RD16A", "column"}, {"WR16A", "column"},
-        {"REFab", "rank"},   {"REFpb",  "rank"},
+        {"REFab", "rank"}, {"REFab_end", "rank"},   {"REFpb",  "rank"},
         {"RFMab", "rank"},   {"RFMpb",  "rank"},
       }
     );
@@ -70,6 +80,7 @@ class LPDDR5 : public IDRAM, public Implementation {
         {"RD16A",  {false,  true,    true,    false}},
         {"WR16A",  {false,  true,    true,    false}},
         {"REFab",  {false,  false,   false,   true }},
+        {"REFab_end", {false,  true,    false,   false}},
         {"REFpb",  {false,  false,   false,   true }},
         {"RFMab",  {false,  false,   false,   true }},
         {"RFMpb",  {false,  false,   false,   true }},
@@ -107,6 +118,23 @@ class LPDDR5 : public IDRAM, public Implementation {
     };
 
 
+  /************************************************
+   *                   Power
+   ***********************************************/
+    inline static constexpr ImplDef m_voltages = {
+      "VDD1", "VDD2H"
+    };
+    
+    inline static constexpr ImplDef m_currents = {
+      "IDD01",  "IDD2N1",  "IDD3N1",  "IDD4R1",  "IDD4W1",  "IDD5AB1",
+      "IDD02H", "IDD2N2H", "IDD3N2H", "IDD4R2H", "IDD4W2H", "IDD5AB2H"
+    };
+
+    inline static constexpr ImplDef m_cmds_counted = {
+      "ACT", "PRE", "RD", "WR", "REF", "REFpb"
+    };
+
+
   /************************************************
    *                 Node States
    ***********************************************/
@@ -138,11 +166,21 @@ class LPDDR5 : public IDRAM, public Implementation {
     FuncMatrix<PreqFunc_t<Node>>    m_preqs;
     FuncMatrix<RowhitFunc_t<Node>>  m_rowhits;
     FuncMatrix<RowopenFunc_t<Node>> m_rowopens;
+    FuncMatrix<PowerFunc_t<Node>>   m_powers;
 
 
   public:
     void tick() override {
       m_clk++;
+
+      // Check if there is any future action at this cycle
+      for (int i = m_future_actions.size() - 1; i >= 0; i--) {
+        auto& future_action = m_future_actions[i];
+        if (future_action.clk == m_clk) {
+          handle_future_action(future_action.cmd, future_action.addr_vec);
+          m_future_actions.erase(m_future_actions.begin() + i);
+        }
+      }
     };
 
     void init() override {
@@ -154,6 +192,7 @@ class LPDDR5 : public IDRAM, public Implementation {
       set_preqs();
       set_rowhits();
       set_rowopens();
+      set_powers();
       
       create_nodes();
     };
@@ -161,7 +200,36 @@ class LPDDR5 : public IDRAM, public Implementation {
     void issue_command(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       m_channels[channel_id]->update_timing(command, addr_vec, m_clk);
+      m_channels[channel_id]->update_powers(command, addr_vec, m_clk);
       m_channels[channel_id]->update_states(command, addr_vec, m_clk);
+
+      // Check if the command requires future action
+      check_future_action(command, addr_vec);
+    };
+
+    void check_future_action(int command, const AddrVec_t& addr_vec) {
+      switch (command) {
+        case m_commands("REFab"):
+          // REFab command requires future action after nRFCab cycles
+          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFCab") - 1});
+          break;
+        default:
+          // Other commands do not require future actions
+          break;
+      }
+    }
+
+    void handle_future_action(int command, const AddrVec_t& addr_vec) {
+      int channel_id = addr_vec[m_levels["channel"]];
+      switch (command) {
+        case m_commands("REFab"):
+          m_channels[channel_id]->update_powers(m_commands("REFab_end"), addr_vec, m_clk);
+          m_channels[channel_id]->update_states(m_commands("REFab_end"), addr_vec, m_clk);
+          break;
+        default:
+          // Other commands do not require future actions
+          break;
+      }
     };
 
     int get_preq_command(int command, const AddrVec_t& addr_vec) override {
@@ -411,21 +479,21 @@ class LPDDR5 : public IDRAM, public Implementation {
       // Rank Actions
       m_actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<LPDDR5>;
       m_actions[m_levels["rank"]][m_commands["CASRD"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        node->m_final_synced_cycle = clk + m_timings["nCL"] + m_timings["nBL16"] + 1; 
+        node->m_final_synced_cycle = clk + node->m_spec->m_timing_vals("nCL") + node->m_spec->m_timing_vals("nBL16") + 1; 
       };
       m_actions[m_levels["rank"]][m_commands["CASWR"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        node->m_final_synced_cycle = clk + m_timings["nCWL"] + m_timings["nBL16"] + 1; 
+        node->m_final_synced_cycle = clk + node->m_spec->m_timing_vals("nCWL") + node->m_spec->m_timing_vals("nBL16") + 1; 
       };
       m_actions[m_levels["rank"]][m_commands["RD16"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        node->m_final_synced_cycle = clk + m_timings["nCL"] + m_timings["nBL16"]; 
+        node->m_final_synced_cycle = clk + node->m_spec->m_timing_vals("nCL") + node->m_spec->m_timing_vals("nBL16"); 
       };
       m_actions[m_levels["rank"]][m_commands["WR16"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
-        node->m_final_synced_cycle = clk + m_timings["nCWL"] + m_timings["nBL16"]; 
+        node->m_final_synced_cycle = clk + node->m_spec->m_timing_vals("nCWL") + node->m_spec->m_timing_vals("nBL16"); 
       };
       // Bank actions
       m_actions[m_levels["bank"]][m_commands["ACT-1"]] = [] (Node* node, int cmd, int target_id, Clk_t clk) {
         node->m_state = m_states["Pre-Opened"];
-        node->m_row_state[target_id] = m_states["Pre-Opened"];
+        node->m_bank_state.open(target_id, m_states["Pre-Opened"], clk);
       };
       m_actions[m_levels["bank"]][m_commands["ACT-2"]] = Lambdas::Action::Bank::ACT<LPDDR5>;
       m_actions[m_levels["bank"]][m_commands["PRE"]]   = Lambdas::Action::Bank::PRE<LPDDR5>;
@@ -440,11 +508,11 @@ class LPDDR5 : public IDRAM, public Implementation {
       m_preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<LPDDR5>;
       m_preqs[m_levels["rank"]][m_commands["RFMab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<LPDDR5>;
 
-      m_preqs[m_levels["rank"]][m_commands["REFpb"]] = [this] (Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+      m_preqs[m_levels["rank"]][m_commands["REFpb"]] = [] (Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
 
         for (auto bg : node->m_child_nodes) {
           for (auto bank : bg->m_child_nodes) {
-            int num_banks_per_bg = m_organization.count[m_levels["bank"]];
+            int num_banks_per_bg = node->m_spec->m_organization.count[m_levels["bank"]];
             int flat_bankid = bank->m_node_id + bg->m_node_id * num_banks_per_bg;
             if (flat_bankid == addr_vec[LPDDR5::m_levels["bank"]] || flat_bankid == addr_vec[LPDDR5::m_levels["bank"]] + 8) {
               switch (node->m_state) {
@@ -466,7 +534,7 @@ class LPDDR5 : public IDRAM, public Implementation {
           case m_states["Closed"]: return m_commands["ACT-1"];
           case m_states["Pre-Opened"]: return m_commands["ACT-2"];
           case m_states["Opened"]: {
-            if (node->m_row_state.find(0) != node->m_row_state.end()) {
+            if (node->m_bank_state.is_open(addr_vec[m_levels["row"]])) {
               Node* rank = node->m_parent_node->m_parent_node;
               if (rank->m_final_synced_cycle < clk) {
                 return m_commands["CASRD"];
@@ -488,7 +556,7 @@ class LPDDR5 : public IDRAM, public Implementation {
           case m_states["Closed"]: return m_commands["ACT-1"];
           case m_states["Pre-Opened"]: return m_commands["ACT-2"];
           case m_states["Opened"]: {
-            if (node->m_row_state.find(0) != node->m_row_state.end()) {
+            if (node->m_bank_state.is_open(addr_vec[m_levels["row"]])) {
               Node* rank = node->m_parent_node->m_parent_node;
               if (rank->m_final_synced_cycle < clk) {
                 return m_commands["CASWR"];
@@ -514,7 +582,7 @@ class LPDDR5 : public IDRAM, public Implementation {
           case m_states["Closed"]: return false;
           case m_states["Pre-Opened"]: return false;
           case m_states["Opened"]:
-            if (node->m_row_state.find(target_id) != node->m_row_state.end()) {
+            if (node->m_bank_state.is_open(target_id)) {
               return true;
             }
             else {
@@ -548,6 +616,36 @@ class LPDDR5 : public IDRAM, public Implementation {
       m_rowopens[m_levels["bank"]][m_commands["WR16"]] = rowopen_func;
     }
 
+    void set_powers() {
+      m_drampower_enable = param<bool>("drampower_enable").default_val(false);
+
+      if (!m_drampower_enable)
+        return;
+
+      Lambdas::Power::Rails::setup<LPDDR5>(this, "nRPpb", "nBL16", "nRFCab");
+
+      m_powers.resize(m_levels.size(), std::vector<PowerFunc_t<Node>>(m_commands.size()));
+
+      m_powers[m_levels["bank"]][m_commands["ACT-2"]]  = Lambdas::Power::Bank::ACT<LPDDR5>;
+      m_powers[m_levels["bank"]][m_commands["PRE"]]    = Lambdas::Power::Bank::PRE<LPDDR5>;
+      m_powers[m_levels["bank"]][m_commands["RD16"]]   = Lambdas::Power::Bank::RD<LPDDR5>;
+      m_powers[m_levels["bank"]][m_commands["WR16"]]   = Lambdas::Power::Bank::WR<LPDDR5>;
+      m_powers[m_levels["bank"]][m_commands["RD16A"]]  = Lambdas::Power::Bank::RDA<LPDDR5>;
+      m_powers[m_levels["bank"]][m_commands["WR16A"]]  = Lambdas::Power::Bank::WRA<LPDDR5>;
+
+      // The row is only open after ACT-2
+      m_powers[m_levels["rank"]][m_commands["ACT-2"]]  = Lambdas::Power::Rank::ACT<LPDDR5>;
+      m_powers[m_levels["rank"]][m_commands["PRE"]]    = Lambdas::Power::Rank::PRE<LPDDR5>;
+      m_powers[m_levels["rank"]][m_commands["RD16A"]]  = Lambdas::Power::Rank::PRE<LPDDR5>;
+      m_powers[m_levels["rank"]][m_commands["WR16A"]]  = Lambdas::Power::Rank::PRE<LPDDR5>;
+      m_powers[m_levels["rank"]][m_commands["PREA"]]   = Lambdas::Power::Rank::PREA<LPDDR5>;
+      m_powers[m_levels["rank"]][m_commands["REFab"]]  = Lambdas::Power::Rank::REFab<LPDDR5>;
+      m_powers[m_levels["rank"]][m_commands["REFab_end"]] = Lambdas::Power::Rank::REFab_end<LPDDR5>;
+      // REFpb refreshes a pair of banks
+      m_powers[m_levels["rank"]][m_commands["REFpb"]]  = Lambdas::Power::Bank::REFpb<LPDDR5, 2>;
+
+    }
+
 
     void create_nodes() {
       int num_channels = m_organization.count[m_levels["channel"]];
@@ -556,6 +654,13 @@ class LPDDR5 : public IDRAM, public Implementation {
         m_channels.push_back(channel);
       }
     };
+
+    void finalize() override {
+      if (!m_drampower_enable)
+        return;
+
+      Lambdas::Power::Rails::finalize<LPDDR5>(this, m_clk);
+    }
 };
 
 
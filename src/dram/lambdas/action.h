@@ -16,13 +16,13 @@ namespace Bank {
   template <class T>
   void ACT(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
     node->m_state = T::m_states["Opened"];
-    node->m_row_state[target_id] = T::m_states["Opened"];
+    node->m_bank_state.open(target_id, T::m_states["Opened"], clk);
   };
 
   template <class T>
   void PRE(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
     node->m_state = T::m_states["Closed"];
-    node->m_row_state.clear();
+    node->m_bank_state.close_all(clk);
   };
 
   template <class T>
@@ -43,7 +43,7 @@ template <class T>
     for (auto bank : node->m_child_nodes) {
       if (bank->m_node_id == target_id) {
         bank->m_state = T::m_states["Closed"];
-        bank->m_row_state.clear();
+        bank->m_bank_state.close_all(clk);
       }
     }
   };
@@ -63,7 +63,7 @@ template <class T>
     for (auto bank : node->m_child_nodes) {
       if (bank->m_node_id == target_id) {
         bank->m_state = T::m_states["Closed"];
-        bank->m_row_state.clear();
+        bank->m_bank_state.close_all(clk);
       }
     }
   }
@@ -75,13 +75,13 @@ namespace Rank {
     if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 1) {
       for (auto bank : node->m_child_nodes) {
         bank->m_state = T::m_states["Closed"];
-        bank->m_row_state.clear();
+        bank->m_bank_state.close_all(clk);
       }
     } else if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 2) {
       for (auto bg : node->m_child_nodes) {
         for (auto bank : bg->m_child_nodes) {
           bank->m_state = T::m_states["Closed"];
-          bank->m_row_state.clear();
+          bank->m_bank_state.close_all(clk);
         }
       }
     } else {
@@ -110,6 +110,26 @@ template <class T>
     }
   };
 
+  template <class T>
+  void PDE(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["PowerDown"];
+  };
+
+  template <class T>
+  void PDX(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["PowerUp"];
+  };
+
+  template <class T>
+  void SRE(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["SelfRefresh"];
+  };
+
+  template <class T>
+  void SRX(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["PowerUp"];
+  };
+
   }       // namespace Rank
 
 namespace Channel {
@@ -120,7 +140,7 @@ namespace Channel {
       for (auto bg : node->m_child_nodes) {
         for (auto bank : bg->m_child_nodes) {
           bank->m_state = T::m_states["Closed"];
-          bank->m_row_state.clear();
+          bank->m_bank_state.close_all(clk);
         }
       }
     } else if constexpr (T::m_levels["bank"] - T::m_levels["channel"] == 3) {
@@ -128,7 +148,7 @@ namespace Channel {
         for (auto bg : pc->m_child_nodes) {
           for (auto bank : bg->m_child_nodes) {
             bank->m_state = T::m_states["Closed"];
-            bank->m_row_state.clear();
+            bank->m_bank_state.close_all(clk);
           }
         }
       }
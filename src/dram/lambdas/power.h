@@ -1,311 +1,339 @@
 #ifndef RAMULATOR_DRAM_LAMBDAS_POWER_H
 #define RAMULATOR_DRAM_LAMBDAS_POWER_H
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <spdlog/spdlog.h>
 
 namespace Ramulator {
 namespace Lambdas {
 namespace Power {
 namespace Bank {
-  template <class T>
-  int get_flat_rank_id(typename T::Node* node) {
-    int channel_id = -1;
-    int rank_id = -1;
-    int num_ranks = node->m_spec->get_level_size("rank");
-    if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 1) {
-      auto rank_node = node->m_parent_node;
-      auto channel_node = rank_node->m_parent_node;
-      rank_id = rank_node->m_node_id;
-      channel_id = channel_node->m_node_id;
-    } else if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 2) {
-      auto bg_node = node->m_parent_node;
-      auto rank_node = bg_node->m_parent_node;
-      auto channel_node = rank_node->m_parent_node;
-      rank_id = rank_node->m_node_id;
-      channel_id = channel_node->m_node_id;
-    }
-    return channel_id * num_ranks + rank_id;
-  }
-
-  template <class T>
-  void debug(typename T::Node* node, std::string msg, Clk_t clk) {
+  template <class T, typename... Args>
+  void debug(typename T::Node* node, Clk_t clk, fmt::format_string<Args...> msg, Args&&... args) {
     if (node->m_spec->m_power_debug) {
-      std::cout << "[Power] Rank" << Bank::get_flat_rank_id<T>(node) << " Bank" << node->m_node_id << " " << msg << " @ " << clk << std::endl;
+      std::cout << "[Power] Rank" << node->m_flat_rank_id << " Bank" << node->m_node_id << " " << fmt::format(msg, std::forward<Args>(args)...) << " @ " << clk << std::endl;
     }
   }
 
   template <class T>
   void ACT(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing ACT counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("ACT")]++;
+    Bank::debug<T>(node, clk, "Incrementing ACT counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("ACT")]++;
   }
 
   template <class T>
   void PRE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing PRE counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("PRE")]++;
+    Bank::debug<T>(node, clk, "Incrementing PRE counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("PRE")]++;
   }
 
   template <class T>
   void RD(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing RD counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("RD")]++;
+    Bank::debug<T>(node, clk, "Incrementing RD counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("RD")]++;
   }
 
   template <class T>
   void WR(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing WR counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("WR")]++;
+    Bank::debug<T>(node, clk, "Incrementing WR counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("WR")]++;
   }
 
   template <class T>
   void VRR(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing VRR counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("VRR")]++;
+    Bank::debug<T>(node, clk, "Incrementing VRR counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("VRR")]++;
   }
 
   template <class T>
   void RVRR(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Bank::debug<T>(node, "Incrementing RVRR counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("RVRR")]++;
+    Bank::debug<T>(node, clk, "Incrementing RVRR counter.");
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("RVRR")]++;
   }
-}      // namespace Bank
 
+  template <class T>
+  void RDA(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Bank::debug<T>(node, clk, "Incrementing RD and PRE counters.");
+    auto& cmd_counters = node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters;
+    cmd_counters[T::m_cmds_counted("RD")]++;
+    cmd_counters[T::m_cmds_counted("PRE")]++;
+  }
 
+  template <class T>
+  void WRA(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Bank::debug<T>(node, clk, "Incrementing WR and PRE counters.");
+    auto& cmd_counters = node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters;
+    cmd_counters[T::m_cmds_counted("WR")]++;
+    cmd_counters[T::m_cmds_counted("PRE")]++;
+  }
 
+  /**
+   * @brief    Counts the banks refreshed by a per-bank (or per-2-bank) refresh command.
+   */
+  template <class T, int num_banks = 1>
+  void REFpb(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Bank::debug<T>(node, clk, "Incrementing REFpb counter by {}.", num_banks);
+    node->m_spec->m_power_stats[node->m_flat_rank_id].cmd_counters[T::m_cmds_counted("REFpb")] += num_banks;
+  }
 
+}      // namespace Bank
 
 
 namespace Rank {
-  template <class T>
-  int get_flat_rank_id(typename T::Node* node) {
-    int num_ranks = node->m_spec->get_level_size("rank");
-    auto channel_node = node->m_parent_node;
-    int rank_id = node->m_node_id;
-    int channel_id = channel_node->m_node_id;
-    return channel_id * num_ranks + rank_id;
+  template <class T, typename... Args>
+  void debug(typename T::Node* node, Clk_t clk, fmt::format_string<Args...> msg, Args&&... args) {
+    if (node->m_spec->m_power_debug) {
+      std::cout << "[Power] Rank" << node->m_flat_rank_id << " " << fmt::format(msg, std::forward<Args>(args)...) << " @ " << clk << std::endl;
+    }
   }
 
-  template <class T>
-  void debug(typename T::Node* node, std::string msg, Clk_t clk) {
-    if (node->m_spec->m_power_debug) {
-      std::cout << "[Power] Rank" << Rank::get_flat_rank_id<T>(node) << " " << msg << " @ " << clk << std::endl;
+  /**
+   * @brief    Calls f on every bank under the node (a rank, or the channel for standards without ranks).
+   */
+  template <class T, typename F>
+  void for_each_bank(typename T::Node* node, F&& f) {
+    if (node->m_level == T::m_levels["bank"]) {
+      f(node);
+      return;
+    }
+    for (auto child : node->m_child_nodes) {
+      for_each_bank<T>(child, f);
     }
   }
 
   template <class T>
   int get_open_bank_count(typename T::Node* node) {
     int bank_count = 0;
-    if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 1) {
-      for (auto bank: node->m_child_nodes) {
-        if (bank->m_state == T::m_states["Opened"]) {
-          bank_count++;
-        }
-      }
-    } else if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 2) {
-      for (auto bg : node->m_child_nodes) {
-        for (auto bank: bg->m_child_nodes) {
-          if (bank->m_state == T::m_states["Opened"]) {
-              bank_count++;
-          }
-        }
+    for_each_bank<T>(node, [&](typename T::Node* bank) {
+      if (bank->m_state == T::m_states["Opened"]) {
+        bank_count++;
       }
-    }
+    });
     return bank_count;
   }
 
   template <class T>
   int get_refreshing_bank_count(typename T::Node* node) {
     int bank_count = 0;
-    if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 1) {
-      for (auto bank: node->m_child_nodes) {
+    if constexpr (T::m_states.contains("Refreshing")) {
+      for_each_bank<T>(node, [&](typename T::Node* bank) {
         if (bank->m_state == T::m_states["Refreshing"]) {
           bank_count++;
         }
-      }
-    } else if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 2) {
-      for (auto bg : node->m_child_nodes) {
-        for (auto bank: bg->m_child_nodes) {
-          if (bank->m_state == T::m_states["Refreshing"]) {
-              bank_count++;
-          }
-        }
-      }
+      });
     }
     return bank_count;
   }
 
   template <class T>
   void ACT(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------ACT------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------ACT------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
     
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
       cur_power_stats.active_start_cycle = clk;
-      std::string msg = "Rank is idle. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles) + "    active_start_cycle: " + std::to_string(cur_power_stats.active_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is idle. idle_cycles: {}    active_start_cycle: {}", cur_power_stats.idle_cycles, cur_power_stats.active_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::ACTIVE;
     }
   }
 
   template <class T>
   void PRE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------PRE------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------PRE------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     bool is_rank_going_idle = get_open_bank_count<T>(node) == 1 && get_refreshing_bank_count<T>(node) == 0; // TODO: AND this PRE is targetting the active bank
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is going idle. active_cycles: " + std::to_string(cur_power_stats.active_cycles) + "    idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is going idle. active_cycles: {}    idle_start_cycle: {}", cur_power_stats.active_cycles, cur_power_stats.idle_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }
   }
 
   template <class T>
   void PREA(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------PREA------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------PREA------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
 
     assert(get_refreshing_bank_count<T>(node) == 0 && "PREA should not be called when there are refreshing banks");
 
     cur_power_stats.cmd_counters[T::m_cmds_counted("PRE")] += get_open_bank_count<T>(node);
-    Rank::debug<T>(node, "Incrementing PRE counter.", clk);
+    Rank::debug<T>(node, clk, "Incrementing PRE counter.");
     if (!is_rank_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is not idle. active_cycles: " + std::to_string(cur_power_stats.active_cycles) + "    idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is not idle. active_cycles: {}    idle_start_cycle: {}", cur_power_stats.active_cycles, cur_power_stats.idle_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }    
   }
 
   template <class T>
   void REFab(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------REFab------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------REFab------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     cur_power_stats.cmd_counters[T::m_cmds_counted("REF")]++;
 
     // We assume rank is idle when REF is called
 
     cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
-    std::string msg = "Refresh starts. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles);
-    Rank::debug<T>(node, msg, clk);
+    Rank::debug<T>(node, clk, "Refresh starts. idle_cycles: {}", cur_power_stats.idle_cycles);
     cur_power_stats.cur_power_state = PowerStats::PowerState::REFRESHING;
   }
 
   template <class T>
   void REFab_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------REFab_end------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------REFab_end------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+    cur_power_stats.idle_start_cycle = clk;
+    Rank::debug<T>(node, clk, "Refresh ends. idle_start_cycle: {}", cur_power_stats.idle_start_cycle);
+    cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
+  }
+
+  /**
+   * @brief    Power-down entry. The rank is precharged (i.e., idle) when it enters power-down.
+   */
+  template <class T>
+  void PDE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, clk, "------PDE------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+
+    cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
+    cur_power_stats.lowpower_start_cycle = clk;
+    Rank::debug<T>(node, clk, "Rank enters power-down. idle_cycles: {}", cur_power_stats.idle_cycles);
+    cur_power_stats.cur_power_state = PowerStats::PowerState::POWER_DOWN;
+  }
+
+  template <class T>
+  void PDX(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, clk, "------PDX------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
 
+    cur_power_stats.powerdown_cycles += clk - cur_power_stats.lowpower_start_cycle;
     cur_power_stats.idle_start_cycle = clk;
-    std::string msg = "Refresh ends. idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle);
-    Rank::debug<T>(node, msg, clk);
+    Rank::debug<T>(node, clk, "Rank exits power-down. powerdown_cycles: {}", cur_power_stats.powerdown_cycles);
+    cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
+  }
+
+  template <class T>
+  void SRE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, clk, "------SRE------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+
+    cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
+    cur_power_stats.lowpower_start_cycle = clk;
+    Rank::debug<T>(node, clk, "Rank enters self-refresh. idle_cycles: {}", cur_power_stats.idle_cycles);
+    cur_power_stats.cur_power_state = PowerStats::PowerState::SELF_REFRESH;
+  }
+
+  template <class T>
+  void SRX(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, clk, "------SRX------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
+
+    cur_power_stats.selfrefresh_cycles += clk - cur_power_stats.lowpower_start_cycle;
+    cur_power_stats.idle_start_cycle = clk;
+    Rank::debug<T>(node, clk, "Rank exits self-refresh. selfrefresh_cycles: {}", cur_power_stats.selfrefresh_cycles);
     cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
   }
 
   template <class T>
   void VRR(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------VRR------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------VRR------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
 
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
       cur_power_stats.active_start_cycle = clk;
-      std::string msg = "Rank is idle. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles) + "    active_start_cycle: " + std::to_string(cur_power_stats.active_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is idle. idle_cycles: {}    active_start_cycle: {}", cur_power_stats.idle_cycles, cur_power_stats.active_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::ACTIVE;
     }
   }
   
   template <class T>
   void VRR_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------VRR_end------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------VRR_end------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     bool is_rank_going_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 1;
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is going idle. idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle) + "    active_cycles: " + std::to_string(cur_power_stats.active_cycles);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is going idle. idle_start_cycle: {}    active_cycles: {}", cur_power_stats.idle_start_cycle, cur_power_stats.active_cycles);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }
   }
 
   template <class T>
   void RFMsb(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------RFMsb------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------RFMsb------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
 
     cur_power_stats.cmd_counters[T::m_cmds_counted("RFM")]++;
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
       cur_power_stats.active_start_cycle = clk;
-      std::string msg = "Rank is idle. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles) + "    active_start_cycle: " + std::to_string(cur_power_stats.active_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is idle. idle_cycles: {}    active_start_cycle: {}", cur_power_stats.idle_cycles, cur_power_stats.active_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::ACTIVE;
     }
   }
 
   template <class T>
   void RFMsb_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------RFMsb_end------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------RFMsb_end------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     size_t num_bankgroups = node->m_child_nodes.size();
     bool is_rank_going_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == num_bankgroups;
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is going idle. idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle) + "    active_cycles: " + std::to_string(cur_power_stats.active_cycles);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is going idle. idle_start_cycle: {}    active_cycles: {}", cur_power_stats.idle_start_cycle, cur_power_stats.active_cycles);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }
   }
 
   template <class T>
   void RRFMsb(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------RRFMsb------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------RRFMsb------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
 
     cur_power_stats.cmd_counters[T::m_cmds_counted("RRFM")]++;
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
       cur_power_stats.active_start_cycle = clk;
-      std::string msg = "Rank is idle. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles) + "    active_start_cycle: " + std::to_string(cur_power_stats.active_start_cycle);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is idle. idle_cycles: {}    active_start_cycle: {}", cur_power_stats.idle_cycles, cur_power_stats.active_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::ACTIVE;
     }
   }
 
   template <class T>
   void RRFMsb_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------RRFMsb_end------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------RRFMsb_end------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
     size_t num_bankgroups = node->m_child_nodes.size();
     bool is_rank_going_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == num_bankgroups;
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is going idle. idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle) + "    active_cycles: " + std::to_string(cur_power_stats.active_cycles);
-      Rank::debug<T>(node, msg, clk);
+      Rank::debug<T>(node, clk, "Rank is going idle. idle_start_cycle: {}    active_cycles: {}", cur_power_stats.idle_start_cycle, cur_power_stats.active_cycles);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }
   }
 
   template <class T>
   void PREsb(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
 
     int open_target_banks = 0;
     bool is_rank_going_idle = true;
@@ -325,16 +353,25 @@ namespace Rank {
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
-      std::string msg = "Rank is going idle. active_cycles: " + std::to_string(cur_power_stats.active_cycles) + "    idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle);
-      Bank::debug<T>(node, msg, clk);
+      Bank::debug<T>(node, clk, "Rank is going idle. active_cycles: {}    idle_start_cycle: {}", cur_power_stats.active_cycles, cur_power_stats.idle_start_cycle);
       cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
     }
   }
 
+  /**
+   * @brief    Sets the energies of the all-bank refresh and of the per-bank refresh, which refreshes 1/num_banks of the rank.
+   */
+  template <class T>
+  void set_REF_energies(std::vector<double>& cmd_energies, double ref_power, int nRFC, double tCK_ns, int num_banks) {
+    double ref_energy = ref_power * nRFC * tCK_ns / 1E3;
+    cmd_energies[T::m_cmds_counted("REF")]   = ref_energy;
+    cmd_energies[T::m_cmds_counted("REFpb")] = ref_energy / num_banks;
+  }
+
   template <class T>
   void finalize_rank(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------finalize_rank------", clk);
-    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    Rank::debug<T>(node, clk, "------finalize_rank------");
+    auto& cur_power_stats = node->m_spec->m_power_stats[node->m_flat_rank_id];
 
     if (cur_power_stats.cur_power_state == PowerStats::PowerState::IDLE) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
@@ -342,11 +379,187 @@ namespace Rank {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
     } else if (cur_power_stats.cur_power_state == PowerStats::PowerState::REFRESHING) {
       // do nothing
+    } else if (cur_power_stats.cur_power_state == PowerStats::PowerState::POWER_DOWN) {
+      cur_power_stats.powerdown_cycles += clk - cur_power_stats.lowpower_start_cycle;
+    } else if (cur_power_stats.cur_power_state == PowerStats::PowerState::SELF_REFRESH) {
+      cur_power_stats.selfrefresh_cycles += clk - cur_power_stats.lowpower_start_cycle;
     }
   }
 
 }       // namespace Rank
 
+
+/**
+ * @brief    Power model setup shared by the standards whose currents are given per voltage rail (HBM, GDDR6, LPDDR5...).
+ * @details
+ * For every voltage in T::m_voltages, T::m_currents lists the IDD0, IDD2N, IDD3N, IDD4R, IDD4W and IDD5(A)B
+ * currents drawn from that rail, in this order. The standard only provides these tables and its m_powers mapping.
+ * The power domain is the rank, or the channel for standards without ranks.
+ */
+namespace Rails {
+  inline constexpr int NUM_RAIL_CURRENTS = 6;
+  enum RailCurrent { IDD0 = 0, IDD2N, IDD3N, IDD4R, IDD4W, IDD5B };
+
+  template <class T>
+  std::string_view get_domain_name() {
+    if constexpr (T::m_levels.contains("rank")) {
+      return "rank";
+    } else {
+      return "channel";
+    }
+  }
+
+  /**
+   * @brief    Calls f on every power domain node under the channel, in flat id order.
+   */
+  template <class T, typename F>
+  void for_each_domain(typename T::Node* node, F&& f) {
+    if (node->m_level == T::Node::get_rank_level()) {
+      f(node);
+      return;
+    }
+    for (auto child : node->m_child_nodes) {
+      for_each_domain<T>(child, f);
+    }
+  }
+
+  /**
+   * @brief    Loads the voltages (from an optional preset) and the currents, each of which can be given individually.
+   */
+  template <class T>
+  void load_power_vals(T* dram) {
+    dram->m_voltage_vals.resize(T::m_voltages.size(), -1);
+    if (auto preset_name = dram->param_group("voltage").template param<std::string>("preset").optional()) {
+      if (T::voltage_presets.count(*preset_name) > 0) {
+        dram->m_voltage_vals = T::voltage_presets.at(*preset_name);
+      } else {
+        throw ConfigurationError("Unrecognized voltage preset \"{}\" in {}!", *preset_name, T::m_name);
+      }
+    }
+    for (int i = 0; i < T::m_voltages.size(); i++) {
+      if (auto val = dram->param_group("voltage").template param<double>(T::m_voltages(i)).optional()) {
+        dram->m_voltage_vals(i) = *val;
+      }
+    }
+
+    dram->m_current_vals.resize(T::m_currents.size(), -1);
+    if (auto preset_name = dram->param_group("current").template param<std::string>("preset").optional()) {
+      if (T::current_presets.count(*preset_name) > 0) {
+        dram->m_current_vals = T::current_presets.at(*preset_name);
+      } else {
+        throw ConfigurationError("Unrecognized current preset \"{}\" in {}!", *preset_name, T::m_name);
+      }
+    }
+    for (int i = 0; i < T::m_currents.size(); i++) {
+      if (auto val = dram->param_group("current").template param<double>(T::m_currents(i)).optional()) {
+        dram->m_current_vals(i) = *val;
+      }
+    }
+
+    for (int i = 0; i < T::m_voltages.size(); i++) {
+      if (dram->m_voltage_vals(i) == -1) {
+        throw ConfigurationError("In \"{}\", voltage {} is not specified!", T::m_name, T::m_voltages(i));
+      }
+    }
+    for (int i = 0; i < T::m_currents.size(); i++) {
+      if (dram->m_current_vals(i) == -1) {
+        throw ConfigurationError("In \"{}\", current {} is not specified!", T::m_name, T::m_currents(i));
+      }
+    }
+  }
+
+  /**
+   * @brief    Sets the background powers and the command energies from the per-rail currents.
+   * @details
+   * ACT, PRE, RD/WR and REF last for nRAS, nRP, nBL and nRFC cycles, whose names differ across standards.
+   */
+  template <class T>
+  void set_energies(T* dram, std::string_view nRP, std::string_view nBL, std::string_view nRFC) {
+    static_assert(T::m_currents.size() == T::m_voltages.size() * NUM_RAIL_CURRENTS);
+
+    auto TS = [&](std::string_view timing) { return dram->m_timing_vals(timing); };
+    // The power drawn from all rails with the given current, or with the difference of the two currents
+    auto P = [&](RailCurrent current, int minus = -1) {
+      double power = 0;
+      for (int rail = 0; rail < T::m_voltages.size(); rail++) {
+        double current_val = dram->m_current_vals(rail * NUM_RAIL_CURRENTS + current);
+        if (minus != -1) {
+          current_val -= dram->m_current_vals(rail * NUM_RAIL_CURRENTS + minus);
+        }
+        power += dram->m_voltage_vals(rail) * current_val;
+      }
+      return power;
+    };
+
+    double tCK_ns = (double) TS("tCK_ps") / 1000.0;
+
+    dram->m_act_background_power = P(IDD3N) * tCK_ns / 1E3;
+    dram->m_pre_background_power = P(IDD2N) * tCK_ns / 1E3;
+
+    dram->m_cmd_energies.resize(T::m_cmds_counted.size(), 0);
+    dram->m_cmd_energies[T::m_cmds_counted("ACT")] = P(IDD0, IDD3N)  * TS("nRAS") * tCK_ns / 1E3;
+    dram->m_cmd_energies[T::m_cmds_counted("PRE")] = P(IDD0, IDD2N)  * TS(nRP)    * tCK_ns / 1E3;
+    dram->m_cmd_energies[T::m_cmds_counted("RD")]  = P(IDD4R, IDD3N) * TS(nBL)    * tCK_ns / 1E3;
+    dram->m_cmd_energies[T::m_cmds_counted("WR")]  = P(IDD4W, IDD3N) * TS(nBL)    * tCK_ns / 1E3;
+
+    // A per-bank refresh refreshes 1/num_banks of what an all-bank refresh does
+    int num_banks = 1;
+    for (int level = T::Node::get_rank_level() + 1; level <= T::m_levels["bank"]; level++) {
+      num_banks *= dram->m_organization.count[level];
+    }
+    Rank::set_REF_energies<T>(dram->m_cmd_energies, P(IDD5B), TS(nRFC), tCK_ns, num_banks);
+  }
+
+  /**
+   * @brief    Loads the power parameters, sets the energies, and sets up and registers the power stats of every domain.
+   */
+  template <class T>
+  void setup(T* dram, std::string_view nRP, std::string_view nBL, std::string_view nRFC) {
+    load_power_vals<T>(dram);
+    set_energies<T>(dram, nRP, nBL, nRFC);
+
+    dram->m_power_debug = dram->template param<bool>("power_debug").default_val(false);
+
+    int num_domains = 1;
+    for (int level = 0; level <= T::Node::get_rank_level(); level++) {
+      num_domains *= dram->m_organization.count[level];
+    }
+    dram->m_power_stats.resize(num_domains);
+    for (int i = 0; i < num_domains; i++) {
+      dram->m_power_stats[i].rank_id = i;
+      dram->m_power_stats[i].cmd_counters.resize(T::m_cmds_counted.size(), 0);
+    }
+
+    dram->register_stat(dram->s_total_background_energy).name("total_background_energy");
+    dram->register_stat(dram->s_total_cmd_energy).name("total_cmd_energy");
+    dram->register_stat(dram->s_total_energy).name("total_energy");
+
+    std::string_view domain = get_domain_name<T>();
+    for (auto& power_stat : dram->m_power_stats) {
+      dram->register_stat(power_stat.total_background_energy).name("total_background_energy_{}{}", domain, power_stat.rank_id);
+      dram->register_stat(power_stat.total_cmd_energy).name("total_cmd_energy_{}{}", domain, power_stat.rank_id);
+      dram->register_stat(power_stat.total_energy).name("total_energy_{}{}", domain, power_stat.rank_id);
+      dram->register_stat(power_stat.act_background_energy).name("act_background_energy_{}{}", domain, power_stat.rank_id);
+      dram->register_stat(power_stat.pre_background_energy).name("pre_background_energy_{}{}", domain, power_stat.rank_id);
+      dram->register_stat(power_stat.active_cycles).name("active_cycles_{}{}", domain, power_stat.rank_id);
+      dram->register_stat(power_stat.idle_cycles).name("idle_cycles_{}{}", domain, power_stat.rank_id);
+    }
+  }
+
+  /**
+   * @brief    Closes the current power state of every domain and accumulates its energy.
+   */
+  template <class T>
+  void finalize(T* dram, Clk_t clk) {
+    for (auto channel : dram->m_channels) {
+      for_each_domain<T>(channel, [&](typename T::Node* domain_node) {
+        Rank::finalize_rank<T>(domain_node, 0, AddrVec_t(), clk);
+        dram->accumulate_rank_energy(dram->m_power_stats[domain_node->m_flat_rank_id]);
+      });
+    }
+  }
+}       // namespace Rails
+
 }       // namespace Power
 }       // namespace Lambdas
 }       // namespace Ramulator
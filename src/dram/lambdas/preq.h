@@ -12,7 +12,7 @@ int RequireRowOpen(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, C
   switch (node->m_state) {
     case T::m_states["Closed"]: return T::m_commands["ACT"];
     case T::m_states["Opened"]: {
-      if (node->m_row_state.find(addr_vec[T::m_levels["row"]]) != node->m_row_state.end()) {
+      if (node->m_bank_state.is_open(addr_vec[T::m_levels["row"]])) {
         return cmd;
       } else {
         return T::m_commands["PRE"];
@@ -69,6 +69,37 @@ int RequireAllBanksClosed(typename T::Node* node, int cmd, const AddrVec_t& addr
   return cmd;
 };
 
+/**
+ * @brief    Wakes the rank up from power-down or self-refresh before any other command is issued to it.
+ */
+template <class T>
+int RequireRankAwake(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+  switch (node->m_state) {
+    case T::m_states["PowerDown"]:   return T::m_commands["PDX"];
+    case T::m_states["SelfRefresh"]: return T::m_commands["SRX"];
+    default:                         return -1;
+  }
+};
+
+template <class T>
+int RequireRankAwakeAndBanksClosed(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+  if (int preq_cmd = RequireRankAwake<T>(node, cmd, addr_vec, clk); preq_cmd != -1) {
+    return preq_cmd;
+  }
+  return RequireAllBanksClosed<T>(node, cmd, addr_vec, clk);
+};
+
+/**
+ * @brief    A rank in self-refresh refreshes itself, so an all-bank refresh sent to it is absorbed without waking it up.
+ */
+template <class T>
+int RequireAllBanksClosedOrSelfRefresh(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+  if (node->m_state == T::m_states["SelfRefresh"]) {
+    return cmd;
+  }
+  return RequireRankAwakeAndBanksClosed<T>(node, cmd, addr_vec, clk);
+};
+
 template <class T>
 int RequireSameBanksClosed(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
   bool all_banks_ready = true;
@@ -12,7 +12,7 @@ namespace Bank {
     switch (node->m_state)  {
       case T::m_states["Closed"]: return false;
       case T::m_states["Opened"]:
-        if (node->m_row_state.find(target_id) != node->m_row_state.end()) {
+        if (node->m_bank_state.is_open(target_id)) {
           return true;
         }
         else {
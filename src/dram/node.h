@@ -1,11 +1,11 @@
 #ifndef RAMULATOR_DRAM_NODE_H
 #define RAMULATOR_DRAM_NODE_H
 
+#include <array>
 #include <vector>
-#include <map>
 #include <deque>
-#include <functional>
 #include <concepts>
+#include <stdexcept>
 
 #include "base/type.h"
 #include "dram/spec.h"
@@ -26,6 +26,59 @@ concept IsDRAMSpec = requires(T t) {
 // };
 
 
+/**
+ * @brief     The row-buffer state of a bank-ish node
+ * @details
+ * A bank only ever has one open row, or a few with subarray-level parallelism (SALP), so the open rows
+ * and their states are kept inline in a small fixed array (scanned linearly) instead of a map.
+ * Opening more than MAX_OPEN_ROWS rows in a bank is an error.
+ *
+ */
+struct BankState {
+  using RowId_t = int;
+  using RowState_t = int;
+  static constexpr int MAX_OPEN_ROWS = 8;
+
+  int num_open_rows = 0;
+  std::array<RowId_t, MAX_OPEN_ROWS> open_rows;
+  std::array<RowState_t, MAX_OPEN_ROWS> row_states;
+
+  Clk_t last_act_clk = -1;   // The last cycle a row was opened in this bank
+  Clk_t last_pre_clk = -1;   // The last cycle this bank was precharged
+
+  int find(RowId_t row) const {
+    for (int i = 0; i < num_open_rows; i++) {
+      if (open_rows[i] == row) {
+        return i;
+      }
+    }
+    return -1;
+  };
+
+  bool is_open(RowId_t row) const { return find(row) != -1; };
+  bool empty() const { return num_open_rows == 0; };
+
+  void open(RowId_t row, RowState_t state, Clk_t clk) {
+    last_act_clk = clk;
+    if (int i = find(row); i != -1) {
+      row_states[i] = state;
+      return;
+    }
+    if (num_open_rows == MAX_OPEN_ROWS) {
+      throw std::runtime_error("[BankState] Cannot open more than BankState::MAX_OPEN_ROWS rows in a bank!");
+    }
+    open_rows[num_open_rows] = row;
+    row_states[num_open_rows] = state;
+    num_open_rows++;
+  };
+
+  void close_all(Clk_t clk) {
+    last_pre_clk = clk;
+    num_open_rows = 0;
+  };
+};
+
+
 /**
  * @brief     CRTP-ish (?) base class of a DRAM Device Node
  * 
@@ -44,12 +97,14 @@ struct DRAMNodeBase {
 
     int m_state = -1;      // The state of the node
 
+    int m_flat_rank_id = -1;  // The flat id (e.g., ch0rank0, ch0rank1... ch1rank0,...) of the rank this node is in, used to index the power stats
+
     std::vector<Clk_t> m_cmd_ready_clk;             // The next cycle that each command can be issued again at this level
     std::vector<std::deque<Clk_t>> m_cmd_history;   // Issue-history of each command at this level
 
-    using RowId_t = int;
-    using RowState_t = int;
-    std::map<RowId_t, RowState_t> m_row_state;  // The state of the rows, if I am a bank-ish node
+    using RowId_t = BankState::RowId_t;
+    using RowState_t = BankState::RowState_t;
+    BankState m_bank_state;  // The state of the rows, if I am a bank-ish node
 
     DRAMNodeBase(T* spec, NodeType* parent, int level, int id):
     m_spec(spec), m_parent_node(parent), m_level(level), m_node_id(id) {
@@ -57,8 +112,9 @@ struct DRAMNodeBase {
       m_cmd_ready_clk.resize(num_cmds, -1);
       m_cmd_history.resize(num_cmds);
       for (int cmd = 0; cmd < num_cmds; cmd++) {
+        // Only the windowed constraints need the issue history
         int window = 0;
-        for (const auto& t : spec->m_timing_cons[level][cmd]) {
+        for (const auto& t : spec->m_timing_cons.windowed(level, cmd)) {
           window = std::max(window, t.window);
         }
         if (window != 0) {
@@ -70,6 +126,12 @@ struct DRAMNodeBase {
 
       m_state = spec->m_init_states[m_level];
 
+      if (m_level <= get_rank_level()) {
+        m_flat_rank_id = (parent ? parent->m_flat_rank_id * spec->m_organization.count[m_level] : 0) + m_node_id;
+      } else {
+        m_flat_rank_id = parent->m_flat_rank_id;
+      }
+
       // Recursively construct next levels
       int next_level = level + 1;
       int last_level = T::m_levels["row"];
@@ -88,6 +150,17 @@ struct DRAMNodeBase {
       }
     };
 
+    /**
+     * @brief    The level at which the power state is kept: the rank, or the channel for standards without ranks (e.g., HBM, GDDR6).
+     */
+    static constexpr int get_rank_level() {
+      if constexpr (T::m_levels.contains("rank")) {
+        return T::m_levels["rank"];
+      } else {
+        return T::m_levels["channel"];
+      }
+    };
+
     void update_states(int command, const AddrVec_t& addr_vec, Clk_t clk) {
       int child_id = addr_vec[m_level+1];
       if (m_spec->m_actions[m_level][command]) {
@@ -136,12 +209,7 @@ struct DRAMNodeBase {
        *         Update Sibling Node Timing
        ***********************************************/
       if (m_node_id != addr_vec[m_level] && addr_vec[m_level] != -1) {
-        for (const auto& t : m_spec->m_timing_cons[m_level][command]) {
-          if (!t.sibling) {
-            // not sibling timing parameter
-            continue; 
-          }
-
+        for (const auto& t : m_spec->m_timing_cons.sibling(m_level, command)) {
           // update earliest schedulable time of every command
           Clk_t future = clk + t.val;
           m_cmd_ready_clk[t.cmd] = std::max(m_cmd_ready_clk[t.cmd], future); 
@@ -159,11 +227,13 @@ struct DRAMNodeBase {
         m_cmd_history[command].push_front(clk); 
       }
 
-      for (const auto& t : m_spec->m_timing_cons[m_level][command]) {
-        if (t.sibling) {
-          continue; 
-        }
+      for (const auto& t : m_spec->m_timing_cons.plain(m_level, command)) {
+        // update earliest schedulable time of every command
+        Clk_t future = clk + t.val;
+        m_cmd_ready_clk[t.cmd] = std::max(m_cmd_ready_clk[t.cmd], future);
+      }
 
+      for (const auto& t : m_spec->m_timing_cons.windowed(m_level, command)) {
         // Get the oldest history
         Clk_t past = m_cmd_history[command][t.window-1];
         if (past < 0) {
@@ -236,14 +306,14 @@ struct DRAMNodeBase {
     };
 
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
-      // TODO: Optimize this by just checking the bank-levels? Have a dedicated bank structure?
+      // TODO: Optimize this by just checking the bank-levels?
       int child_id = addr_vec[m_level+1];
       if (m_spec->m_rowhits[m_level][command]) {
         // stop recursion: there is a row hit at this level
         return m_spec->m_rowhits[m_level][command](static_cast<NodeType*>(this), command, child_id, m_clk);  
       }
 
-      if (!m_child_nodes.size()) {
+      if (child_id < 0 || !m_child_nodes.size()) {
         // stop recursion: there were no row hits at any level
         return false; 
       }
@@ -267,27 +337,47 @@ struct DRAMNodeBase {
       // recursively check for row opens at my child
       return m_child_nodes[child_id]->check_rowbuffer_open(command, addr_vec, m_clk);
     }    
+
+    bool check_node_open(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
+      return check_rowbuffer_open(command, addr_vec, m_clk);
+    }
 };
 
+// The spec functions are plain function pointers (not std::function) so that the calls are not type-erased.
+// Non-capturing lambdas convert to them implicitly; anything spec-specific should be reached through node->m_spec.
 template<class T>
-using ActionFunc_t = std::function<void(typename T::Node* node, int cmd, int target_id, Clk_t clk)>;
+using ActionFunc_t = void (*)(typename T::Node* node, int cmd, int target_id, Clk_t clk);
 template<class T>
-using PreqFunc_t   = std::function<int (typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk)>;
+using PreqFunc_t   = int  (*)(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk);
 template<class T>
-using RowhitFunc_t = std::function<bool(typename T::Node* node, int cmd, int target_id, Clk_t clk)>;
+using RowhitFunc_t = bool (*)(typename T::Node* node, int cmd, int target_id, Clk_t clk);
 template<class T>
-using RowopenFunc_t = std::function<bool(typename T::Node* node, int cmd, int target_id, Clk_t clk)>;
+using RowopenFunc_t = bool (*)(typename T::Node* node, int cmd, int target_id, Clk_t clk);
 template<class T>
-using PowerFunc_t = std::function<void(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk)>;
+using PowerFunc_t = void (*)(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk);
 
+/**
+ * @brief    A dense [level][command] table of spec functions.
+ * @details
+ * All entries live in one contiguous array (level-major) instead of a vector of vectors, so a lookup
+ * is a single indexed load. Unset entries are nullptr.
+ *
+ */
 template<typename T>
-using FuncMatrix = std::vector<std::vector<T>>;
-
-// TODO: Enable easy syntax for FuncMatrix lookup
-// template<typename T, int N, int M>
-// class FuncMatrix : public std::array<std::array<T, M>, N> {
+class FuncMatrix {
+  private:
+    std::vector<T> m_funcs;
+    int m_num_cmds = 0;
+
+  public:
+    void resize(int num_levels, const std::vector<T>& row) {
+      m_num_cmds = row.size();
+      m_funcs.assign(num_levels * m_num_cmds, nullptr);
+    };
 
-// };
+    T* operator[](int level) { return m_funcs.data() + level * m_num_cmds; };
+    const T* operator[](int level) const { return m_funcs.data() + level * m_num_cmds; };
+};
 
 }        // namespace Ramulator
 
@@ -7,6 +7,7 @@
 #include <map>
 #include <array>
 #include <ranges>
+#include <span>
 #include <stdexcept>
 
 #include <spdlog/spdlog.h>
@@ -65,7 +66,83 @@ struct TimingConsEntry {
   };
 };
 
-using TimingCons = std::vector<std::vector<std::vector<TimingConsEntry>>>;
+// A timing constraint that only needs the issue time of the preceding command
+struct TimingConsValue {
+  /// The command that the timing constraint is constraining.
+  int cmd;
+  /// The value of the timing constraint (in number of cycles).
+  int val;
+};
+
+/**
+ * @brief    Flattened timing constraint table of a DRAM standard.
+ * @details
+ * The constraints of every (level, preceding command) pair are stored contiguously in one of three
+ * dense arrays, so that update_timing() does not have to branch on the entry flags:
+ *  - plain:    constraints on the target node with a window of 1 and no blocked offset (ready = clk + val)
+ *  - windowed: constraints that need the issue history (e.g., nFAW) or have a blocked offset
+ *  - sibling:  constraints applied to the siblings of the target node (ready = clk + val)
+ * The shape of the table is fixed by the number of levels and commands of the standard, only the
+ * values are patched in at init from the timing preset.
+ *
+ */
+class TimingCons {
+  private:
+    int m_num_levels = 0;
+    int m_num_cmds = 0;
+
+    std::vector<TimingConsValue> m_plain;
+    std::vector<TimingConsEntry> m_windowed;
+    std::vector<TimingConsValue> m_sibling;
+    // Start offset of each (level, command) in each array, one extra entry marks the end
+    std::vector<int> m_plain_offsets;
+    std::vector<int> m_windowed_offsets;
+    std::vector<int> m_sibling_offsets;
+
+    template<typename E>
+    std::span<const E> get(const std::vector<E>& entries, const std::vector<int>& offsets, int level, int cmd) const {
+      int key = level * m_num_cmds + cmd;
+      return {entries.data() + offsets[key], entries.data() + offsets[key + 1]};
+    };
+
+  public:
+    int num_levels() const { return m_num_levels; };
+    int num_commands() const { return m_num_cmds; };
+
+    std::span<const TimingConsValue> plain(int level, int cmd) const { return get(m_plain, m_plain_offsets, level, cmd); };
+    std::span<const TimingConsEntry> windowed(int level, int cmd) const { return get(m_windowed, m_windowed_offsets, level, cmd); };
+    std::span<const TimingConsValue> sibling(int level, int cmd) const { return get(m_sibling, m_sibling_offsets, level, cmd); };
+
+    /**
+     * @brief    Flattens the constraints given per [level][preceding command].
+     */
+    void build(int num_levels, int num_cmds, const std::vector<std::vector<std::vector<TimingConsEntry>>>& cons) {
+      m_num_levels = num_levels;
+      m_num_cmds = num_cmds;
+      m_plain.clear();
+      m_windowed.clear();
+      m_sibling.clear();
+      m_plain_offsets.assign(1, 0);
+      m_windowed_offsets.assign(1, 0);
+      m_sibling_offsets.assign(1, 0);
+      for (int level = 0; level < num_levels; level++) {
+        for (int cmd = 0; cmd < num_cmds; cmd++) {
+          for (const auto& t : cons[level][cmd]) {
+            if (t.sibling) {
+              m_sibling.push_back({t.cmd, t.val});
+            } else if (t.window == 1 && t.blocked_offset <= 0) {
+              m_plain.push_back({t.cmd, t.val});
+            } else {
+              m_windowed.push_back(t);
+            }
+          }
+          m_plain_offsets.push_back(m_plain.size());
+          m_windowed_offsets.push_back(m_windowed.size());
+          m_sibling_offsets.push_back(m_sibling.size());
+        }
+      }
+    };
+};
 
 // // TODO: Write a expression parser and evaluator
 // template<class T>
@@ -87,17 +164,20 @@ struct TimingConsInitializer {
 
 template<class T>
 void populate_timingcons(T* spec, std::vector<TimingConsInitializer> initializer) {
-  spec->m_timing_cons.resize(T::m_levels.size(), std::vector<std::vector<TimingConsEntry>>(T::m_commands.size()));
+  constexpr int num_levels = T::m_levels.size();
+  constexpr int num_cmds = T::m_commands.size();
+  std::vector<std::vector<std::vector<TimingConsEntry>>> timing_cons(num_levels, std::vector<std::vector<TimingConsEntry>>(num_cmds));
   for (const auto& ts : initializer) {
     int level = T::m_levels(ts.level);  // cannot be consteval...
     for (auto p_cmd_str : ts.preceding) {
       int p_cmd = T::m_commands(p_cmd_str);
       for (auto f_cmd_str : ts.following) {
         int f_cmd = T::m_commands(f_cmd_str);
-        spec->m_timing_cons[level][p_cmd].push_back({f_cmd, ts.latency, ts.window, ts.blocked_offset, ts.is_sibling});
+        timing_cons[level][p_cmd].push_back({f_cmd, ts.latency, ts.window, ts.blocked_offset, ts.is_sibling});
       }
     }
   }
+  spec->m_timing_cons.build(num_levels, num_cmds, timing_cons);
 };
 
 
@@ -168,6 +248,15 @@ class ImplDef : public std::array<std::string_view, N> {
       throw "NON EXISTENT NAME";
     };
 
+    consteval bool contains(std::string_view name) const {
+      for (int i = 0; i < N; i++) {
+        if (std::array<std::string_view, N>::operator[](i) == name) {
+          return true;
+        } 
+      }
+      return false;
+    };
+
     constexpr std::string_view operator()(int i) const {
       if (i < N) {
         return std::array<std::string_view, N>::operator[](i);
@@ -303,12 +392,16 @@ struct PowerStats {
     enum class PowerState {
       IDLE = 0,
       ACTIVE = 1,
-      REFRESHING = 2
+      REFRESHING = 2,
+      POWER_DOWN = 3,
+      SELF_REFRESH = 4
     };
     PowerState cur_power_state = PowerState::IDLE;
 
     double act_background_energy = 0;
     double pre_background_energy = 0;
+    double powerdown_background_energy = 0;
+    double selfrefresh_background_energy = 0;
 
     double total_background_energy = 0;
     double total_cmd_energy = 0;
@@ -318,9 +411,12 @@ struct PowerStats {
 
     Clk_t active_cycles = 0;
     Clk_t idle_cycles = 0;
+    Clk_t powerdown_cycles = 0;
+    Clk_t selfrefresh_cycles = 0;
 
     Clk_t active_start_cycle = -1; // initially rank is not active
     Clk_t idle_start_cycle = 0;
+    Clk_t lowpower_start_cycle = -1; // when the rank entered power-down or self-refresh
     
 };        
 
@@ -17,6 +17,15 @@ class IBHScheduler {
     virtual void tick() = 0;
     virtual ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) = 0;
     virtual ReqBuffer::iterator get_best_request(ReqBuffer& buffer) = 0;
+
+    /**
+     * @brief    Whether the last get_best_request held back the buffer's requests to mitigate RowHammer
+     *           (e.g., all of them target throttled rows).
+     * @details
+     * The controller uses this to attribute idle cycles to RowHammer mitigation.
+     *
+     */
+    virtual bool is_blocking_for_mitigation() { return false; };
 };
 
 }       // namespace Ramulator
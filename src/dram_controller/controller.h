@@ -13,6 +13,7 @@
 #include "dram_controller/plugin.h"
 #include "dram_controller/refresh.h"
 #include "dram_controller/rowpolicy.h"
+#include "dram_controller/power_manager.h"
 
 
 namespace Ramulator {
@@ -25,6 +26,7 @@ class IDRAMController : public Clocked<IDRAMController> {
     IScheduler*   m_scheduler = nullptr;
     IRefreshManager*   m_refresh = nullptr;
     IRowPolicy*   m_rowpolicy = nullptr;
+    IPowerManager*   m_power_manager = nullptr;   // Optional
     std::vector<IControllerPlugin*> m_plugins;
 
     int m_channel_id = -1;
@@ -44,6 +46,13 @@ class IDRAMController : public Clocked<IDRAMController> {
      */
     virtual bool priority_send(Request& req) = 0;
 
+    /**
+     * @brief       Returns the number of requests of a rank in this channel waiting in the read, write, and active buffers
+     *              (needed by the controllers that support a power manager).
+     * 
+     */
+    virtual int get_num_outstanding(int rank) { return 0; };
+
     /**
      * @brief       Ticks the memory controller.
      * 
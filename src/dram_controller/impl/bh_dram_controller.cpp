@@ -1,4 +1,5 @@
 #include "dram_controller/bh_controller.h"
+#include "dram_controller/impl/utilization_stats.h"
 #include "memory_system/memory_system.h"
 #include "frontend/frontend.h"
 #include "frontend/impl/processor/bhO3/bhllc.h"
@@ -39,6 +40,9 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
     int s_num_row_misses = 0;
     int s_num_row_conflicts = 0;
 
+    // Bus utilization, idle-cycle causes, and bank-level parallelism
+    UtilizationStats m_utilization;
+
     // DEBUG STAT
     int m_invalidate_ctr = -1;
 
@@ -86,6 +90,8 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
       register_stat(s_num_row_hits).name("controller_num_row_hits");
       register_stat(s_num_row_misses).name("controller_num_row_misses");
       register_stat(s_num_row_conflicts).name("controller_num_row_conflicts");
+
+      m_utilization.setup(this, m_dram, m_channel_id);
     };
 
     bool send(Request& req) override {
@@ -119,6 +125,7 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
         req.arrive = -1;
         return false;
       }
+      m_utilization.add_outstanding(req.addr_vec, 1);
 
       return true;
     };
@@ -152,6 +159,13 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
         plugin->update(request_found, req_it);
       }
 
+      // 3.1 Account bus utilization and bank-level parallelism of this cycle
+      if (m_utilization.update(request_found, req_it)) {
+        const ReqBuffer& serving_buffer = m_active_buffer.size() != 0 ? m_active_buffer : (m_is_write_mode ? m_write_buffer : m_read_buffer);
+        bool has_requests = m_active_buffer.size() != 0 || m_read_buffer.size() != 0 || m_write_buffer.size() != 0;
+        m_utilization.attribute_idle_cycle(m_priority_buffer, has_requests, m_scheduler->is_blocking_for_mitigation(), serving_buffer);
+      }
+
       // 4. Finally, issue the commands to serve the request
       if (request_found) {
         // If we find a real request to serve
@@ -165,9 +179,15 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
           } else if (req_it->type_id == Request::Type::Write) {
             // TODO: Add code to update statistics
           }
+          if (buffer != &m_priority_buffer) {
+            m_utilization.add_outstanding(req_it->addr_vec, -1);
+          }
           buffer->remove(req_it);
         } else {
           if (m_dram->m_command_meta(req_it->command).is_opening) {
+            if (buffer == &m_priority_buffer) {
+              m_utilization.add_outstanding(req_it->addr_vec, 1);
+            }
             m_active_buffer.enqueue(*req_it);
             buffer->remove(req_it);
           }
@@ -214,10 +234,12 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
       if (!m_is_write_mode) {
         if ((m_write_buffer.size() > m_wr_high_watermark * m_write_buffer.max_size) || m_read_buffer.size() == 0) {
           m_is_write_mode = true;
+          m_utilization.count_rw_switch();
         }
       } else {
         if ((m_write_buffer.size() < m_wr_low_watermark * m_write_buffer.max_size) && m_read_buffer.size() != 0) {
           m_is_write_mode = false;
+          m_utilization.count_rw_switch();
         }
       }
     };
@@ -305,6 +327,7 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
     }
 
     void finalize() override {
+      m_utilization.finalize();
     }
 };
 }   // namespace Ramulator
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "dram_controller/controller.h"
+#include "dram_controller/impl/utilization_stats.h"
 #include "memory_system/memory_system.h"
 
 namespace Ramulator {
@@ -49,6 +50,11 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
     size_t s_read_latency = 0;
     float s_avg_read_latency = 0;
 
+    // Bus utilization, idle-cycle causes, and bank-level parallelism
+    UtilizationStats m_utilization;
+    int m_rank_level = -1;                        // The rank level (-1 if the DRAM has no ranks)
+    std::vector<int> m_rank_num_outstanding;      // Number of requests of each rank in the active, read, and write buffers
+
 
   public:
     void init() override {
@@ -58,6 +64,9 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       m_scheduler = create_child_ifce<IScheduler>();
       m_refresh = create_child_ifce<IRefreshManager>();    
       m_rowpolicy = create_child_ifce<IRowPolicy>();    
+      if (m_config["PowerManager"]) {
+        m_power_manager = create_child_ifce<IPowerManager>();
+      }
 
       if (m_config["plugins"]) {
         YAML::Node plugin_configs = m_config["plugins"];
@@ -71,6 +80,8 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       m_dram = memory_system->get_ifce<IDRAM>();
       m_bank_addr_idx = m_dram->m_levels("bank");
       m_priority_buffer.max_size = 512*3 + 32;
+      // Plugins send priority requests while holding an iterator to the scheduled request, so the buffer must never reallocate
+      m_priority_buffer.buffer.reserve(m_priority_buffer.max_size + 1);
 
       m_num_cores = frontend->get_num_cores();
 
@@ -108,6 +119,12 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
       register_stat(s_read_latency).name("read_latency_{}", m_channel_id);
       register_stat(s_avg_read_latency).name("avg_read_latency_{}", m_channel_id);
+
+      if (m_dram->m_levels.contains("rank")) {
+        m_rank_level = m_dram->m_levels("rank");
+        m_rank_num_outstanding.resize(m_dram->m_organization.count[m_rank_level], 0);
+      }
+      m_utilization.setup(this, m_dram, m_channel_id);
     };
 
     bool send(Request& req) override {
@@ -156,6 +173,8 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
         req.arrive = -1;
         return false;
       }
+      update_outstanding(req.addr_vec, 1);
+      m_scheduler->on_enqueue(req);
 
       return true;
     };
@@ -168,6 +187,10 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       return is_success;
     }
 
+    int get_num_outstanding(int rank) override {
+      return m_rank_level == -1 ? 0 : m_rank_num_outstanding[rank];
+    };
+
     void tick() override {
       m_clk++;
 
@@ -181,6 +204,9 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       serve_completed_reads();
 
       m_refresh->tick();
+      if (m_power_manager) {
+        m_power_manager->tick();
+      }
 
       // 2. Try to find a request to serve.
       ReqBuffer::iterator req_it;
@@ -190,25 +216,28 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       // 2.1 Take row policy action
       m_rowpolicy->update(request_found, req_it);
 
+      // 2.2 Let the power manager observe the decision (e.g., to track idle ranks)
+      if (m_power_manager) {
+        m_power_manager->update(request_found, req_it);
+      }
+
+      // 2.3 Let the scheduler observe the decision (e.g., to update thread ranks)
+      m_scheduler->update(request_found, req_it);
+
       // 3. Update all plugins
       for (auto plugin : m_plugins) {
         plugin->update(request_found, req_it);
       }
 
+      // 3.1 Account bus utilization and bank-level parallelism of this cycle
+      if (m_utilization.update(request_found, req_it)) {
+        const ReqBuffer& serving_buffer = m_active_buffer.size() != 0 ? m_active_buffer : (m_is_write_mode ? m_write_buffer : m_read_buffer);
+        bool has_requests = m_active_buffer.size() != 0 || m_read_buffer.size() != 0 || m_write_buffer.size() != 0;
+        m_utilization.attribute_idle_cycle(m_priority_buffer, has_requests, false, serving_buffer);
+      }
+
       // 4. Finally, issue the commands to serve the request
       if (request_found) {
-        if(req_it->is_first) {
-          req_it->is_first = false;
-          bool row_hit = m_dram->check_rowbuffer_hit(req_it->final_command, req_it->addr_vec);
-          bool row_open = m_dram->check_rowbuffer_open(req_it->final_command, req_it->addr_vec);
-          if (row_hit) {
-            s_num_row_hits++;
-          } else if (row_open) {
-            s_num_row_conflicts++;
-          } else {
-            s_num_row_misses++;
-          }
-        }
         // If we find a real request to serve
         if (req_it->is_stat_updated == false) {
           update_request_stats(req_it);
@@ -225,9 +254,17 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
             if(req_it->callback)
               req_it->callback(*req_it);
           }
+          if (buffer != &m_priority_buffer) {
+            update_outstanding(req_it->addr_vec, -1);
+            m_scheduler->on_retire(*req_it);
+          }
           buffer->remove(req_it);
         } else {
           if (m_dram->m_command_meta(req_it->command).is_opening) {
+            if (buffer == &m_priority_buffer) {
+              update_outstanding(req_it->addr_vec, 1);
+              m_scheduler->on_enqueue(*req_it);
+            }
             m_active_buffer.enqueue(*req_it);
             buffer->remove(req_it);
           }
@@ -237,9 +274,6 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
     };
 
-    void finalize() override {
-      spdlog::info("Row hits: {}, Row misses: {}, Row conflicts: {}", s_num_row_hits, s_num_row_misses, s_num_row_conflicts);
-    }
   private:
     /**
      * @brief    Helper function to check if a request is hitting an open row
@@ -341,10 +375,12 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       if (!m_is_write_mode) {
         if ((m_write_buffer.size() > m_wr_high_watermark * m_write_buffer.max_size) || m_read_buffer.size() == 0) {
           m_is_write_mode = true;
+          m_utilization.count_rw_switch();
         }
       } else {
         if ((m_write_buffer.size() < m_wr_low_watermark * m_write_buffer.max_size) && m_read_buffer.size() != 0) {
           m_is_write_mode = false;
+          m_utilization.count_rw_switch();
         }
       }
     };
@@ -367,6 +403,10 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       // 2.2    If no requests can be scheduled from the act buffer, check the rest of the buffers
       if (!request_found) {
         // 2.2.1    We first check the priority buffer to prioritize e.g., maintenance requests
+        // Drop a low-power entry at the head of the priority buffer if requests arrived at its rank since it was sent
+        if (m_power_manager && m_priority_buffer.size() != 0 && m_power_manager->is_stale(*m_priority_buffer.begin())) {
+          m_priority_buffer.remove(m_priority_buffer.begin());
+        }
         if (m_priority_buffer.size() != 0) {
           req_buffer = &m_priority_buffer;
           req_it = m_priority_buffer.begin();
@@ -414,6 +454,17 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       return request_found;
     }
 
+    /**
+     * @brief    Tracks the number of outstanding (i.e., enqueued and not yet served) read/write requests of each bank and rank
+     *
+     */
+    void update_outstanding(const AddrVec_t& addr_vec, int delta) {
+      if (m_rank_level != -1) {
+        m_rank_num_outstanding[std::max(addr_vec[m_rank_level], 0)] += delta;
+      }
+      m_utilization.add_outstanding(addr_vec, delta);
+    }
+
     void finalize() override {
       s_avg_read_latency = (float) s_read_latency / (float) s_num_read_reqs;
 
@@ -422,6 +473,8 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       s_write_queue_len_avg = (float) s_write_queue_len / (float) m_clk;
       s_priority_queue_len_avg = (float) s_priority_queue_len / (float) m_clk;
 
+      m_utilization.finalize();
+
       return;
     }
 
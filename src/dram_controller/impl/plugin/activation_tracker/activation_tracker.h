@@ -0,0 +1,229 @@
+#ifndef RAMULATOR_PLUGIN_ACTIVATION_TRACKER_H_
+#define RAMULATOR_PLUGIN_ACTIVATION_TRACKER_H_
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace Ramulator {
+
+struct NoTrackerData {};
+
+/**
+ * @brief    Per-bank table of row activation counters shared by the counter-based RowHammer mitigations.
+ * @details
+ * In the bounded mode, the table has a fixed number of entries and implements the Misra-Gries (a.k.a. space-saving)
+ * heavy-hitter algorithm of Graphene: an activation to a row that is not in a full table replaces an entry whose count
+ * equals the spillover counter (i.e., a minimum-count entry) with count spillover + 1, or increments the spillover
+ * counter if there is none. In the exact mode, the table grows so that every activated row has its own counter.
+ *
+ * The entries are stored densely (the rows, the counters and an optional data_t per entry in separate arrays) so that
+ * the search for the minimum counter is a linear scan the compiler vectorizes. An open-addressed (linear probing)
+ * index maps the rows to the entries. Erasing an entry moves the last entry into its place, so iterating the entries
+ * backwards while erasing visits each entry exactly once.
+ */
+template <typename data_t = NoTrackerData>
+class ActivationTracker {
+  public:
+    ActivationTracker() : ActivationTracker(1, true) {};
+
+    /**
+     * @param num_entries   The capacity of the table (the initial capacity in the exact mode)
+     * @param exact         Whether the table grows instead of evicting entries
+     */
+    ActivationTracker(int num_entries, bool exact) : m_num_entries(std::max(num_entries, 1)), m_exact(exact) {
+      m_rows.reserve(m_num_entries);
+      m_counts.reserve(m_num_entries);
+      m_data.reserve(m_num_entries);
+      resize_index(m_num_entries);
+    };
+
+    int size() const { return m_rows.size(); };
+    bool is_full() const { return !m_exact && size() >= m_num_entries; };
+    int spillover() const { return m_spillover; };
+
+    int row(int entry) const { return m_rows[entry]; };
+    int& count(int entry) { return m_counts[entry]; };
+    data_t& data(int entry) { return m_data[entry]; };
+
+    /**
+     * @brief    Returns the entry of the row, or -1 if the row is not in the table
+     */
+    int find(int row) const {
+      int slot = home_slot(row);
+      while (m_index[slot].row != -1) {
+        if (m_index[slot].row == row) {
+          return m_index[slot].entry;
+        }
+        slot = (slot + 1) & m_index_mask;
+      }
+      return -1;
+    };
+
+    /**
+     * @brief    Inserts a row that is not in the table and returns its entry
+     * @details
+     * The counter of the new entry starts at spillover + 1. Returns -1 (and increments the spillover counter) if the
+     * table is full and no entry can be evicted.
+     */
+    int insert(int row) {
+      int entry = -1;
+      if (!is_full()) {
+        entry = size();
+        m_rows.push_back(row);
+        m_counts.push_back(m_spillover + 1);
+        m_data.emplace_back();
+        if (2 * size() > m_index_mask + 1) {
+          resize_index(2 * size());
+        } else {
+          index_insert(row, entry);
+        }
+        return entry;
+      }
+
+      entry = find_count(m_spillover);
+      if (entry == -1) {
+        m_spillover++;
+        return -1;
+      }
+      index_erase(m_rows[entry]);
+      m_rows[entry] = row;
+      m_counts[entry] = m_spillover + 1;
+      m_data[entry] = data_t();
+      index_insert(row, entry);
+      return entry;
+    };
+
+    /**
+     * @brief    Records an activation to the row and returns its entry (or -1 if the activation spilled over)
+     */
+    int activate(int row) {
+      int entry = find(row);
+      if (entry == -1) {
+        return insert(row);
+      }
+      m_counts[entry]++;
+      return entry;
+    };
+
+    /**
+     * @brief    Removes an entry, moving the last entry into its place
+     */
+    void erase(int entry) {
+      index_erase(m_rows[entry]);
+      int last = size() - 1;
+      if (entry != last) {
+        m_rows[entry] = m_rows[last];
+        m_counts[entry] = m_counts[last];
+        m_data[entry] = std::move(m_data[last]);
+        m_index[find_slot(m_rows[entry])].entry = entry;
+      }
+      m_rows.pop_back();
+      m_counts.pop_back();
+      m_data.pop_back();
+    };
+
+    /**
+     * @brief    Sets all counters (and the spillover counter) to zero, keeping the tracked rows
+     */
+    void reset_counts() {
+      std::fill(m_counts.begin(), m_counts.end(), 0);
+      m_spillover = 0;
+    };
+
+    /**
+     * @brief    Removes all entries
+     */
+    void clear() {
+      m_rows.clear();
+      m_counts.clear();
+      m_data.clear();
+      std::fill(m_index.begin(), m_index.end(), IndexSlot());
+      m_spillover = 0;
+    };
+
+  private:
+    struct IndexSlot {
+      int row = -1;     // -1 if the slot is empty
+      int entry = -1;
+    };
+
+    int m_num_entries = -1;
+    bool m_exact = false;
+    int m_spillover = 0;
+
+    std::vector<int> m_rows;
+    std::vector<int> m_counts;
+    std::vector<data_t> m_data;
+
+    std::vector<IndexSlot> m_index;
+    int m_index_mask = 0;
+    int m_index_shift = 0;
+
+    int home_slot(int row) const {
+      return ((uint32_t) row * 2654435769u) >> m_index_shift;
+    };
+
+    int find_slot(int row) const {
+      int slot = home_slot(row);
+      while (m_index[slot].row != row) {
+        slot = (slot + 1) & m_index_mask;
+      }
+      return slot;
+    };
+
+    // Returns the first entry whose counter equals the value
+    int find_count(int value) const {
+      const int* counts = m_counts.data();
+      int num_counts = m_counts.size();
+      // Counters never go below the spillover counter, so only look for the value if it is the minimum
+      int min_count = value + 1;
+      for (int i = 0; i < num_counts; i++) {
+        min_count = std::min(min_count, counts[i]);
+      }
+      if (min_count != value) {
+        return -1;
+      }
+      return std::find(counts, counts + num_counts, value) - counts;
+    };
+
+    void index_insert(int row, int entry) {
+      int slot = home_slot(row);
+      while (m_index[slot].row != -1) {
+        slot = (slot + 1) & m_index_mask;
+      }
+      m_index[slot] = {row, entry};
+    };
+
+    // Removes the row from the index, shifting the rest of its probe sequence back so that no tombstones are needed
+    void index_erase(int row) {
+      int hole = find_slot(row);
+      for (int slot = (hole + 1) & m_index_mask; m_index[slot].row != -1; slot = (slot + 1) & m_index_mask) {
+        int home = home_slot(m_index[slot].row);
+        // the slot can move into the hole only if the hole is between its home slot and the slot
+        if (((slot - home) & m_index_mask) >= ((slot - hole) & m_index_mask)) {
+          m_index[hole] = m_index[slot];
+          hole = slot;
+        }
+      }
+      m_index[hole] = IndexSlot();
+    };
+
+    // Rebuilds the index with at least twice as many slots as entries
+    void resize_index(int num_entries) {
+      int log2_slots = 1;
+      while ((1 << log2_slots) < 2 * num_entries) {
+        log2_slots++;
+      }
+      m_index.assign(1 << log2_slots, IndexSlot());
+      m_index_mask = (1 << log2_slots) - 1;
+      m_index_shift = 32 - log2_slots;
+      for (int entry = 0; entry < size(); entry++) {
+        index_insert(m_rows[entry], entry);
+      }
+    };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_PLUGIN_ACTIVATION_TRACKER_H_
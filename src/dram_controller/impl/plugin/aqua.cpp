@@ -6,6 +6,7 @@
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
+#include "dram_controller/impl/plugin/activation_tracker/activation_tracker.h"
 #include "translation/translation.h"
 #include "addr_mapper/impl/rit.h"
 #include "dram_controller/impl/plugin/device_config/device_config.h"
@@ -46,13 +47,11 @@ class AQUA : public IControllerPlugin, public Implementation {
     int m_num_rows_per_bank = -1;
     int m_num_cls = -1;
 
-    // per bank hot-row tracker (same as Graphene)
+    // per bank hot-row tracker (same as Graphene, with its spillover counter)
     // indexed using flattened <rank id, bank id>
     // e.g., if rank 0, bank 4, index is 4
     // if rank 1, bank 5, index is 16 (assuming 16 banks/rank) + 5
-    std::vector<std::unordered_map<int, int>> m_aggressor_row_tracker;
-    // spillover counter per bank
-    std::vector<int> m_spillover_counter;
+    std::vector<ActivationTracker<>> m_aggressor_row_tracker;
     // per bank row indirection table is implemented in 'src/addr_mapper/impl/linear_mappers_with_rit.cpp'
 
     std::vector<std::unordered_map<int, int>> m_reverse_pointer_table;
@@ -101,15 +100,8 @@ class AQUA : public IControllerPlugin, public Implementation {
       m_num_cls = m_dram->get_level_size("column") / 8;
 
       // Initialize hot-row tracker
-      for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-        std::unordered_map<int, int> table;
-        m_aggressor_row_tracker.push_back(table);
-
-        std::unordered_map<int, int> rpt;
-        m_reverse_pointer_table.push_back(rpt);
-      }
-      // Initialize spillover counter
-      m_spillover_counter = std::vector<int>(m_num_banks_per_rank * m_num_ranks, 0);
+      m_aggressor_row_tracker.resize(m_num_banks_per_rank * m_num_ranks, ActivationTracker<>(m_num_art_entries, false));
+      m_reverse_pointer_table.resize(m_num_banks_per_rank * m_num_ranks);
       // Initialize row indirection table in the addr_mapper
       m_addr_mapper->init_rit(m_num_banks_per_rank * m_num_ranks, m_num_fpt_entries * 2);
 
@@ -140,10 +132,8 @@ class AQUA : public IControllerPlugin, public Implementation {
 
       if (m_clk % m_reset_period_clk == 0) {
         // Reset hrt and unlock rit
-        for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-          m_aggressor_row_tracker[i].clear();
-          m_spillover_counter[i] = 0;
-          // m_addr_mapper->rit_unlock();
+        for (auto& art : m_aggressor_row_tracker) {
+          art.clear();
         }
       }
 
@@ -165,73 +155,39 @@ class AQUA : public IControllerPlugin, public Implementation {
           }
 
           // Check HRT
-          if (m_aggressor_row_tracker[flat_bank_id].find(row_id) == m_aggressor_row_tracker[flat_bank_id].end()) {
+          ActivationTracker<>& art = m_aggressor_row_tracker[flat_bank_id];
+          int entry = art.find(row_id);
+          if (entry == -1) {
             if (m_is_debug) {
               std::cout << "  └  " << "row " << row_id << " not in HRT." << std::endl;
             }
-            // if row is not in the table, check if the table is full 
-            if (m_aggressor_row_tracker[flat_bank_id].size() < m_num_art_entries) {
-              if (m_is_debug) {
-                std::cout << "  └  " << "HRT is not full, inserting with count 1." << std::endl;
-              }
-              // if table is not full, insert the row
-              m_aggressor_row_tracker[flat_bank_id][row_id] = 1;
-            } else {
+            // if row is not in the table, insert it if the table is not full,
+            // otherwise replace a row whose count equals the spillover counter
+            entry = art.insert(row_id);
+            if (entry == -1) {
               if (m_is_debug) {
-                std::cout << "  └  " << "HRT is full, searching for a row to evict." << std::endl;
-              }
-              // if table is full, find a row to evict
-              bool found = false;
-              int to_remove = -1;
-              int spillover_value = -1;
-
-              for (auto it = m_aggressor_row_tracker[flat_bank_id].begin(); it != m_aggressor_row_tracker[flat_bank_id].end(); it++) {
-                // if we find an entry with spillover counter value, evict it
-                if (it->second == m_spillover_counter[flat_bank_id]) {
-                  if (m_is_debug) {
-                    std::cout << "  └  " << "found a row to evict: " << it->first << std::endl;
-                  }
-                  // if we find an entry, record it
-                  spillover_value = it->second;
-                  to_remove = it->first;
-                  found = true;
-                  break;
-                }
-              }
-
-              if (found) {
-                if (m_is_debug) {
-                  std::cout << "Removing row " << to_remove << " from HRT." << std::endl;
-                  std::cout << "Adding row " << row_id << " to HRT." << std::endl;
-                }
-                // remove to_remove from the table
-                m_aggressor_row_tracker[flat_bank_id].erase(to_remove);
-                // add row_id to the table
-                m_aggressor_row_tracker[flat_bank_id][row_id] = spillover_value + 1;
-              }
-              else {
-                if (m_is_debug) {
-                  std::cout << "  └  " << "no row to evict, incrementing spillover counter." << std::endl;
-                }
-                m_spillover_counter[flat_bank_id] += 1;
-                return;
+                std::cout << "  └  " << "no row to evict, incrementing spillover counter." << std::endl;
               }
+              return;
+            }
+            if (m_is_debug) {
+              std::cout << "Adding row " << row_id << " to HRT." << std::endl;
             }
           } else {
             if (m_is_debug) { 
               std::cout << "  └  " << "row " << row_id << " in HRT. Incrementing its counter." << std::endl;
             }
             // if row in table, increment its activation count
-            m_aggressor_row_tracker[flat_bank_id][row_id] += 1;
+            art.count(entry) += 1;
           }
           // dump HRT for debug
           // if (m_is_debug) {
           //   std::cout << "==========================" << std::endl;
-          //   std::cout << "HRT[" << flat_bank_id << "].size(): " << m_hot_row_tracker[flat_bank_id].size() << std::endl;
-          //   for (auto entry: m_hot_row_tracker[flat_bank_id]) {
-          //     std::cout << entry.first << ":\t" << entry.second << std::endl; 
+          //   std::cout << "HRT[" << flat_bank_id << "].size(): " << art.size() << std::endl;
+          //   for (int i = 0; i < art.size(); i++) {
+          //     std::cout << art.row(i) << ":\t" << art.count(i) << std::endl; 
           //   }
-          //   std::cout << "Spillover counter: " << m_spillover_counter[flat_bank_id] << std::endl;
+          //   std::cout << "Spillover counter: " << art.spillover() << std::endl;
           //   std::cout << "==========================" << std::endl;
           // }
 
@@ -239,9 +195,9 @@ class AQUA : public IControllerPlugin, public Implementation {
           if (m_is_debug) {
             std::cout << "Row " << row_id << " in ART" << std::endl;
             std::cout << "  └  " << "threshold: " << m_art_threshold << std::endl;
-            std::cout << "  └  " << "count: " << m_aggressor_row_tracker[flat_bank_id][row_id] << std::endl;
+            std::cout << "  └  " << "count: " << art.count(entry) << std::endl;
           }
-          if (m_aggressor_row_tracker[flat_bank_id][row_id] % m_art_threshold == 0) {
+          if (art.count(entry) % m_art_threshold == 0) {
             if (m_is_debug) {
               std::cout << "Row " << row_id << " needs quarantine!" << std::endl;
               std::cout << "  └  " << "RQA head: " << m_rqa_head << std::endl;
@@ -14,6 +14,7 @@
 #include <array>
 #include <vector>
 #include <utility>
+#include <memory>
 
 #include "blockhammer.h"
 #include "blockhammer_util.h"
@@ -31,8 +32,9 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
 
   typedef int elem_t;
   typedef uint16_t ctr_t;
-  using SubFilter = CountingBloomFilter<elem_t, ctr_t>;
-  using BaseFilter = UnifiedBloomFilter<elem_t, SubFilter>;
+  using BaseFilter = IBloomFilter<elem_t>;
+  template <int num_hashes>
+  using SubFilter = CountingBloomFilter<elem_t, ctr_t, num_hashes>;
 
   public:
     // blockhammer configuration parameters
@@ -53,11 +55,10 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
   private:
     IDRAM* m_dram = nullptr;
     BHO3LLC* m_llc;
-    std::vector<BaseFilter*> m_filters;
-    std::vector<HistoryBuffer<elem_t>*> m_histbufs;
+    std::vector<std::unique_ptr<BaseFilter>> m_filters;
+    std::vector<HistoryBuffer<elem_t>> m_histbufs;
     std::unordered_set<int> m_blacklisted_rows;
-    std::vector<std::unordered_map<int ,int>*> m_activations; 
-    AttackThrottler* m_attack_throttler;
+    std::unique_ptr<AttackThrottler> m_attack_throttler;
 
     int m_clk = -1;
     
@@ -82,7 +83,18 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
         accumulated_dimension *= m_dram->m_organization.count[i + 1];
         flat_bank_id += req.addr_vec[i] * accumulated_dimension;
       }
-      return m_filters[flat_bank_id];
+      return m_filters[flat_bank_id].get();
+    }
+
+    // Creates the per bank filters with num_hashes hash functions (the filters are specialized on the number of hashes)
+    template <int num_hashes>
+    void create_filters() {
+      SubFilter<num_hashes> sub_filter(m_bf_ctr_count, m_bf_ctr_thresh, m_bf_ctr_saturate);
+      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
+        m_filters.push_back(std::make_unique<UnifiedBloomFilter<elem_t, SubFilter<num_hashes>>>(
+          m_bf_num_filters, sub_filter, m_bf_len_epoch_clk, m_llc
+        ));
+      }
     }
   
   public:
@@ -132,37 +144,30 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
         exit(0);
       }
 
-      auto* hash_functions = new std::vector<bloom_hash_fn>();
-      uint32_t size = m_bf_ctr_count;
-      for (int i = 0; i < m_bf_num_hashes; i++)  {
-        hash_functions->push_back([i, size](uint32_t key) {
-          uint32_t hash1 = key * 2654435761;
-          uint32_t hash2 = hash1 + i * ((key * 2246822519 % (size - 1)) + 1);
-          return hash2;
-        });
+      if (m_bf_ctr_count < 2 || (m_bf_ctr_count & (m_bf_ctr_count - 1)) != 0) {
+        throw ConfigurationError("[BlockHammer] The number of counters per filter ({}) must be a power of two!", m_bf_ctr_count);
       }
-
-      // TODO: These pointers are currently never deleted.
-      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-        auto* sub_filters = new std::vector<SubFilter*>();
-        for (int j = 0; j < m_bf_num_filters; j++) {
-          sub_filters->push_back(new SubFilter(
-            m_bf_ctr_count, m_bf_ctr_thresh,
-            m_bf_ctr_saturate, *hash_functions
-          ));
-        }
-        m_filters.push_back(new BaseFilter(*sub_filters, m_bf_len_epoch_clk, m_llc));
-        m_activations.push_back(new std::unordered_map<int, int>);
+      if (m_bf_num_filters <= 0) {
+        throw ConfigurationError("[BlockHammer] The number of filters ({}) must be positive!", m_bf_num_filters);
       }
-      m_filters[m_num_ranks * m_num_banks_per_rank - 1]->insert(0);
-      m_filters[m_num_ranks * m_num_banks_per_rank - 1]->reset();
 
-      for (int i = 0; i < m_num_ranks; i++) {
-        m_histbufs.push_back(new HistoryBuffer<elem_t>(m_bf_hist_size, m_bf_hist_max_freq));
+      switch (m_bf_num_hashes) {
+        case 1: create_filters<1>(); break;
+        case 2: create_filters<2>(); break;
+        case 3: create_filters<3>(); break;
+        case 4: create_filters<4>(); break;
+        case 5: create_filters<5>(); break;
+        case 6: create_filters<6>(); break;
+        case 7: create_filters<7>(); break;
+        case 8: create_filters<8>(); break;
+        default:
+          throw ConfigurationError("[BlockHammer] The number of hash functions ({}) must be in [1, 8]!", m_bf_num_hashes);
       }
 
-      m_attack_throttler = new AttackThrottler(m_llc, m_bf_num_rh, m_bf_ctr_thresh, m_bf_len_epoch_clk,
-                                                m_bf_trefw, m_bf_num_filters);
+      m_histbufs.resize(m_num_ranks, HistoryBuffer<elem_t>(m_bf_hist_size, m_bf_hist_max_freq));
+
+      m_attack_throttler = std::make_unique<AttackThrottler>(m_llc, m_bf_num_rh, m_bf_ctr_thresh, m_bf_len_epoch_clk,
+                                                              m_bf_trefw, m_bf_num_filters);
 
       if (m_is_debug) {
         std::cout << "------------------------------------" << std::endl
@@ -188,11 +193,11 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
       m_clk++;
 
-      for (int i = 0; i < m_num_ranks; i++) {
-        m_histbufs[i]->update();
+      for (auto& histbuf : m_histbufs) {
+        histbuf.update();
       }
-      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-        m_filters[i]->update();
+      for (auto& filter : m_filters) {
+        filter->update();
       }
       m_attack_throttler->update();
 
@@ -212,7 +217,7 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
       // Update bloom filters and history buffer.
       auto rank_idx = req_it->addr_vec[m_rank_level];
       auto row_addr = req_it->addr_vec[m_row_level];
-      m_histbufs[rank_idx]->insert(row_addr);
+      m_histbufs[rank_idx].insert(row_addr);
       auto* filter = get_bank_filter(*req_it);
       filter->insert(row_addr);
 
@@ -240,10 +245,8 @@ class BlockHammer : public IControllerPlugin, public Implementation, public IBlo
       if (is_opening && is_row) {
         auto rank_idx = req.addr_vec[m_rank_level];
         auto row_addr = req.addr_vec[m_row_level];
-        auto* filter = get_bank_filter(req);
-        bool filter_test = filter->test(row_addr);
-        bool histbuf_search = m_histbufs[rank_idx]->search(row_addr);
-        return !filter_test || !histbuf_search;
+        // Only search the history buffer if the row is blacklisted by the filter
+        return !get_bank_filter(req)->test(row_addr) || !m_histbufs[rank_idx].search(row_addr);
       }
       return true;
     }
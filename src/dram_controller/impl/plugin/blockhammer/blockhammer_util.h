@@ -1,13 +1,15 @@
 #ifndef RAMULATOR_PLUGIN_BLOCKHAMMER_FILTER_
 #define RAMULATOR_PLUGIN_BLOCKHAMMER_FILTER_
 
-#include <functional>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <type_traits>
 #include <cstdint>
 
 namespace Ramulator {
 
-typedef std::function<uint32_t(uint32_t)> bloom_hash_fn;
-
 template <typename elem_t>
 struct HistoryEntry {
   elem_t entry;
@@ -17,62 +19,90 @@ struct HistoryEntry {
 template <typename elem_t>
 class IBloomFilter {
 public:
+  virtual ~IBloomFilter() = default;
   virtual void insert(elem_t elem) = 0;
   virtual bool test(elem_t elem) = 0;
   virtual void reset() = 0;
+  // Advances the filter by one cycle (for the filters that change over time)
+  virtual void update() { };
 };      // class IBloomFilter
 
-template <typename elem_t, typename ctr_t>
+/**
+ * @brief    A counting Bloom filter with num_hashes hash functions (fixed at compile time) and a power-of-two number
+ *           of counters.
+ * @details
+ * The i-th hash of an element is h1 + i * h2 (double hashing), so the counter indices of all hash functions are computed
+ * at once from two multiplicative hashes, and each index is a mask instead of a modulo.
+ */
+template <typename elem_t, typename ctr_t, int num_hashes>
 class CountingBloomFilter : public IBloomFilter<elem_t> {
 public:
-  CountingBloomFilter(int num_counters, int ctr_thresh, bool saturate,
-        std::vector<bloom_hash_fn>& hash_functions) : m_hash_functions(hash_functions) {
-      // Initializers looks ugly here, opting for manual assignment
-      this->m_num_counters = num_counters;
-      this->m_ctr_thresh = ctr_thresh;
-      this->m_saturate = m_saturate;
-      m_counters.resize(m_num_counters);
-      reset();
-  }
-
-  ~CountingBloomFilter() {
-    m_counters.clear();
+  using Indices = std::array<uint32_t, num_hashes>;
+
+  CountingBloomFilter(int num_counters, int ctr_thresh, bool saturate) {
+    m_num_counters = num_counters;
+    m_ctr_thresh = ctr_thresh;
+    m_saturate = saturate;
+    m_counters.resize(m_num_counters);
+    reset();
+  }
+
+  // The counter index of each hash function
+  Indices hash(elem_t elem) const {
+    uint32_t key = elem;
+    uint32_t hash1 = key * 2654435761u;
+    uint32_t hash2 = ((uint64_t) key * 2246822519u % (m_num_counters - 1)) + 1;
+    Indices indices;
+    for (int i = 0; i < num_hashes; i++) {
+      indices[i] = (hash1 + i * hash2) & (m_num_counters - 1);
+    }
+    return indices;
   }
 
-  virtual void insert(elem_t elem) override {
-    for (int i = 0; i < m_hash_functions.size(); i++) {
-      uint32_t idx = m_hash_functions[i](elem) % m_num_counters;
-      if (!m_saturate || m_counters[idx] < m_ctr_thresh) {
-        m_counters[idx]++;
+  void insert(const Indices& indices) {
+    for (int i = 0; i < num_hashes; i++) {
+      ctr_t& counter = m_counters[indices[i]];
+      if (!m_saturate || counter < m_ctr_thresh) {
+        counter++;
       }
     }
   }
 
-  virtual bool test(elem_t elem) override {
+  bool test(const Indices& indices) const {
     bool pass = true;
-    for (int i = 0; i < m_hash_functions.size(); i++) {
-      uint32_t idx = m_hash_functions[i](elem) % m_num_counters;
-      pass &= m_counters[idx] >= m_ctr_thresh;
+    for (int i = 0; i < num_hashes; i++) {
+      pass &= m_counters[indices[i]] >= m_ctr_thresh;
     }
     return pass;
   }
 
+  virtual void insert(elem_t elem) override {
+    insert(hash(elem));
+  }
+
+  virtual bool test(elem_t elem) override {
+    return test(hash(elem));
+  }
+
   virtual void reset() override {
     std::fill(m_counters.begin(), m_counters.end(), (ctr_t) 0);
   }
 
 private:
-  int m_num_counters;
+  uint32_t m_num_counters;
   int m_ctr_thresh;
   bool m_saturate;
   std::vector<ctr_t> m_counters;
-  std::vector<bloom_hash_fn>& m_hash_functions;
 };      // class CountingBloomFilter
 
+/**
+ * @brief    Time-interleaved filters: every element is inserted into all filters, the oldest filter is tested and
+ *           cleared every len_epoch cycles.
+ */
 template <typename elem_t, class T>
 class UnifiedBloomFilter : public IBloomFilter<elem_t> {
 public:
-  UnifiedBloomFilter(std::vector<T*>& filters, int len_epoch, BHO3LLC* llc) : m_filters(filters) {
+  UnifiedBloomFilter(int num_filters, const T& filter, int len_epoch, BHO3LLC* llc) : m_filters(num_filters, filter) {
     static_assert(std::is_base_of<IBloomFilter<elem_t>, T>::value, "Template T must be a subclass of IBloomFilter");
     this->m_len_epoch = len_epoch;
     this->m_tick = 0;
@@ -80,38 +110,36 @@ public:
     this->m_llc = llc;
   }
 
-  ~UnifiedBloomFilter() {
-    m_filters.clear();
-  }
-
-  void update() {
+  virtual void update() override {
     m_tick++;
     if (m_tick >= m_len_epoch) {
       m_tick = 0;
-      m_filters[m_test_idx]->reset();
+      m_filters[m_test_idx].reset();
       m_test_idx = (m_test_idx + 1) % m_filters.size();
     }
   }
 
   virtual void insert(elem_t elem) override {
-    for (T* filter : m_filters) {
-      filter->insert(elem);
+    // All filters have the same geometry, so the indices are only hashed once
+    auto indices = m_filters[0].hash(elem);
+    for (T& filter : m_filters) {
+      filter.insert(indices);
     }
   }
 
   virtual bool test(elem_t elem) override {
-    return m_filters[m_test_idx]->test(elem);
+    return m_filters[m_test_idx].test(elem);
   }
 
   virtual void reset() override {
-    for (T* filter : m_filters) {
-      filter->reset();
+    for (T& filter : m_filters) {
+      filter.reset();
     }
   }
 
 private:
   int m_len_epoch;
-  std::vector<T*>& m_filters;
+  std::vector<T> m_filters;
   uint64_t m_tick;
   uint32_t m_test_idx;
   BHO3LLC* m_llc;
@@ -1,11 +1,11 @@
 #include <vector>
-#include <unordered_map>
 #include <limits>
 #include <random>
 
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
+#include "dram_controller/impl/plugin/activation_tracker/activation_tracker.h"
 
 namespace Ramulator {
 
@@ -33,13 +33,11 @@ class Graphene : public IControllerPlugin, public Implementation {
     int m_num_banks_per_rank = -1;
     int m_num_rows_per_bank = -1;
 
-    // per bank activation count table
+    // per bank activation count table (with its spillover counter)
     // indexed using flattened <rank id, bank id>
     // e.g., if rank 0, bank 4, index is 4
     // if rank 1, bank 5, index is 16 (assuming 16 banks/rank) + 5
-    std::vector<std::unordered_map<int, int>> m_activation_count_table;
-    // spillover counter per bank
-    std::vector<int> m_spillover_counter;
+    std::vector<ActivationTracker<>> m_activation_count_table;
 
 
   public:
@@ -73,16 +71,7 @@ class Graphene : public IControllerPlugin, public Implementation {
       m_num_rows_per_bank = m_dram->get_level_size("row");
 
       // Initialize bank act count tables
-      for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-        std::unordered_map<int, int> table;
-        for (int j = -m_num_rows_per_bank; j < -m_num_rows_per_bank + m_num_table_entries; j++) {
-          table.insert(std::make_pair(j, 0));
-        }
-        m_activation_count_table.push_back(table);
-      }
-
-      // Initialize spillover counter
-      m_spillover_counter = std::vector<int>(m_num_banks_per_rank * m_num_ranks, 0);
+      m_activation_count_table.resize(m_num_banks_per_rank * m_num_ranks, ActivationTracker<>(m_num_table_entries, false));
     };
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
@@ -91,10 +80,8 @@ class Graphene : public IControllerPlugin, public Implementation {
 
       if (m_clk % m_reset_period_clk == 0) {
         // Reset
-        for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-          for (auto it = m_activation_count_table[i].begin(); it != m_activation_count_table[i].end(); it++)
-            it->second = 0;
-          m_spillover_counter[i] = 0;
+        for (auto& table : m_activation_count_table) {
+          table.reset_counts();
         }
       }
 
@@ -117,63 +104,38 @@ class Graphene : public IControllerPlugin, public Implementation {
             std::cout << "  └  " << "index: " << flat_bank_id << std::endl;
           }
 
-          if (m_activation_count_table[flat_bank_id].find(row_id) == m_activation_count_table[flat_bank_id].end()) {
-            // if row is not in the table, find an entry 
-            // with a count equal to that of the spillover counter
-            bool found = false;
-            int to_remove = -1;
-            int spillover_value = -1;
-
-            for (auto it = m_activation_count_table[flat_bank_id].begin(); it != m_activation_count_table[flat_bank_id].end(); it++) {
-              if (m_is_debug)
-                std::cout << "  └  " << "checking row " << it->first << " with count " << it->second << std::endl;
-
-              if (it->second == m_spillover_counter[flat_bank_id]) {
-                // if we find an entry, record it
-                spillover_value = it->second;
-                to_remove = it->first;
-                found = true;
-                break;
-              }
-            }
-            if (found) {
-              // for debug
-              if (m_is_debug) {
-                // print the row that is being removed
-                std::cout << "Removing row " << to_remove << " from table " << flat_bank_id << std::endl;
-                // print the row that is being added
+          ActivationTracker<>& table = m_activation_count_table[flat_bank_id];
+          int entry = table.find(row_id);
+          if (entry == -1) {
+            // if row is not in the table, replace an entry with a count equal to that of the spillover counter
+            // if there is no such entry, the spillover counter is incremented by one
+            entry = table.insert(row_id);
+            if (m_is_debug) {
+              if (entry != -1) {
                 std::cout << "Adding row " << row_id << " to table " << flat_bank_id << std::endl;
-                std::cout << "  └  " << "spillover counter: " << m_spillover_counter[flat_bank_id] << std::endl;
               }
-              // remove to_remove from the table
-              m_activation_count_table[flat_bank_id].erase(to_remove);
-              // add row_id to the table
-              m_activation_count_table[flat_bank_id][row_id] = spillover_value + 1;
-            }
-            // if we did not find such an entry, increment spillover counter by one
-            else {
-              m_spillover_counter[flat_bank_id] += 1;
+              std::cout << "  └  " << "spillover counter: " << table.spillover() << std::endl;
             }
           }
           else {
             // if row in table, increment its activation count
-            m_activation_count_table[flat_bank_id][row_id] += 1;
+            table.count(entry) += 1;
             
             if (m_is_debug) {
               std::cout << "Row " << row_id << " in table[" << flat_bank_id << "]" << std::endl;
               std::cout << "  └  " << "threshold: " << m_activation_threshold << std::endl;
-              std::cout << "  └  " << "count: " << m_activation_count_table[flat_bank_id][row_id] << std::endl;
+              std::cout << "  └  " << "count: " << table.count(entry) << std::endl;
             }
 
             // check if the count exceeds the threshold
-            if (m_activation_count_table[flat_bank_id][row_id] >= m_activation_threshold) {
+            if (table.count(entry) >= m_activation_threshold) {
               if (m_is_debug) {
                 std::cout << "Row " << row_id << " in table " << flat_bank_id << " has exceeded the threshold!" << std::endl;
               }
               // if yes, schedule preventive refreshes
               Request vrr_req(req_it->addr_vec, m_VRR_req_id);
               m_ctrl->priority_send(vrr_req);
-              m_activation_count_table[flat_bank_id][row_id] = m_spillover_counter[flat_bank_id];
+              table.count(entry) = table.spillover();
             }
           }
         }
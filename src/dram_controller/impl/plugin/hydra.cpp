@@ -1,5 +1,5 @@
 #include <vector>
-#include <unordered_map>
+#include <algorithm>
 #include <limits>
 #include <bitset>
 #include <iomanip>
@@ -24,8 +24,13 @@ class Hydra : public IControllerPlugin, public Implementation {
     IAddrMapper* m_addr_mapper = nullptr;
 
     struct GCT_Entry {
-      int group_count;
-      bool initialized;
+      int group_count = 0;
+      bool initialized = false;
+    };
+
+    enum class RCCPolicy {
+      RANDOM,
+      MIN_COUNT
     };
 
     int m_clk = -1;
@@ -36,7 +41,8 @@ class Hydra : public IControllerPlugin, public Implementation {
     int m_row_group_size = -1;
     int m_reset_period_ns = -1;
     int m_rcc_num_per_rank = -1;
-    std::string m_rcc_policy = "RANDOM";
+    std::string m_rcc_policy_name = "RANDOM";
+    RCCPolicy m_rcc_policy = RCCPolicy::RANDOM;
 
     int m_reset_period_clk = -1;
 
@@ -61,6 +67,7 @@ class Hydra : public IControllerPlugin, public Implementation {
     int m_gct_entries_per_bank = -1;
     int m_gct_index_bits = -1;
     int m_rcc_set_num = -1;
+    int m_rcc_assoc = 16;
     int m_rcc_index_bits = -1;
     int m_rcc_tag_row_bits = -1;
     int m_rcc_tag_bits = -1;
@@ -72,29 +79,26 @@ class Hydra : public IControllerPlugin, public Implementation {
     int m_group_rct_cl_size = -1;
 
     // per bank GCT, 
-    // the first index is the flat bank id
-    // the second index is the row group id
+    // indexed using the flat bank id * m_gct_entries_per_bank + the row group id
     // each entry has a group counter and a flag indicating if the group counter has beed initialized
     // the row group id uses the most significant bits of the row id
-    std::vector<std::unordered_map<Addr_t, GCT_Entry>> group_count_table;
+    std::vector<GCT_Entry> group_count_table;
     // per bank RCT,
-    // the first index is the flat bank id
-    // the second index is the row id
+    // indexed using the flat bank id * m_num_rows_per_bank + the row id
     // each entry has a row counter
-    std::vector<std::unordered_map<Addr_t, int>> row_count_table;
+    std::vector<int> row_count_table;
     // per rank RCC,
-    // a 16-set associative cache
-    // the first index is the rank id
-    // the second index is the rcc set id
-    // each entry has an rcc tag and a row counter
+    // a m_rcc_assoc-way set associative cache
+    // indexed using (the rank id * m_rcc_set_num + the rcc set id) * m_rcc_assoc + the way
+    // each way has an rcc tag (-1 if invalid) and a row counter
     // the rcc set id uses the least significant bits of the row id
     // the rcc tag uses the most significant bits of the row id and the bank id
-    std::vector<std::vector<std::unordered_map<Addr_t, int>>> row_count_cache;
+    std::vector<int> rcc_tags;
+    std::vector<int> rcc_counters;
     // per bank RCT count table,
-    // the first index is the flat bank id
-    // the second index is the row id
+    // indexed using the flat bank id * m_total_rct_row_size + the row id (only the rows that store the RCT)
     // each entry has a row counter
-    std::vector<std::unordered_map<Addr_t, int>> rct_count_table;
+    std::vector<int> rct_count_table;
 
     // rng for random policy
     std::mt19937 generator;
@@ -122,8 +126,16 @@ class Hydra : public IControllerPlugin, public Implementation {
       m_row_group_size = param<int>("hydra_row_group_size").default_val(128);
       m_reset_period_ns = param<int>("hydra_reset_period_ns").default_val(64000000);
       m_rcc_num_per_rank = param<int>("hydra_rcc_num_per_rank").default_val(4096);
-      m_rcc_policy = param<std::string>("hydra_rcc_policy").default_val("RANDOM");
+      m_rcc_policy_name = param<std::string>("hydra_rcc_policy").default_val("RANDOM");
       m_is_debug = param<bool>("debug").default_val(false);
+
+      if (m_rcc_policy_name == "RANDOM") {
+        m_rcc_policy = RCCPolicy::RANDOM;
+      } else if (m_rcc_policy_name == "MIN_COUNT") {
+        m_rcc_policy = RCCPolicy::MIN_COUNT;
+      } else {
+        throw ConfigurationError("Undefined RCC eviction policy.");
+      }
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -161,7 +173,7 @@ class Hydra : public IControllerPlugin, public Implementation {
       m_counter_bits = ceil(log2(m_tracking_threshold) / 8) * 8;
       m_gct_entries_per_bank = m_num_rows_per_bank / m_row_group_size;
       m_gct_index_bits = log2(m_gct_entries_per_bank);
-      m_rcc_set_num = m_rcc_num_per_rank / 16;
+      m_rcc_set_num = m_rcc_num_per_rank / m_rcc_assoc;
       m_rcc_index_bits = log2(m_rcc_set_num);
       m_rcc_tag_row_bits = m_row_address_bits - m_rcc_index_bits;
       m_rcc_tag_bits = m_rcc_tag_row_bits + m_bank_address_bits;
@@ -178,30 +190,11 @@ class Hydra : public IControllerPlugin, public Implementation {
       m_group_rct_cl_size = m_row_group_size * m_counter_bits / 512;
 
       // Initialize tables
-      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-        std::unordered_map<Addr_t, GCT_Entry> gct_bank;
-        group_count_table.push_back(gct_bank);
-      }
-
-      for (int i = 0; i < m_num_ranks; i++) {
-        std::vector<std::unordered_map<Addr_t, int>> rcc_rank;
-        for (int j = 0 ; j < m_rcc_set_num; j++){
-          std::unordered_map<Addr_t, int> rcc_set;
-          rcc_rank.push_back(rcc_set);
-        }
-        row_count_cache.push_back(rcc_rank);
-      }
-      
-      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-        std::unordered_map<Addr_t, int> row_count_table_bank;
-        row_count_table.push_back(row_count_table_bank);
-      }
-
-      rct_count_table.resize(m_num_ranks * m_num_banks_per_rank);
-      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-        std::unordered_map<Addr_t, int> rctct_bank;
-        rct_count_table.push_back(rctct_bank);
-      }
+      group_count_table.resize(m_num_ranks * m_num_banks_per_rank * m_gct_entries_per_bank);
+      row_count_table.resize((size_t) m_num_ranks * m_num_banks_per_rank * m_num_rows_per_bank, 0);
+      rcc_tags.resize(m_num_ranks * m_rcc_set_num * m_rcc_assoc, -1);
+      rcc_counters.resize(m_num_ranks * m_rcc_set_num * m_rcc_assoc, 0);
+      rct_count_table.resize(m_num_ranks * m_num_banks_per_rank * m_total_rct_row_size, 0);
 
       if (m_is_debug) {
         std::cout << "------------------------------------" << std::endl
@@ -215,7 +208,7 @@ class Hydra : public IControllerPlugin, public Implementation {
         std::cout << "m_row_group_size:           " << m_row_group_size << std::endl;
         std::cout << "m_reset_period_ns:          " << m_reset_period_ns << std::endl;
         std::cout << "m_rcc_num_per_rank:         " << m_rcc_num_per_rank << std::endl;
-        std::cout << "m_rcc_policy:               " << m_rcc_policy << std::endl;
+        std::cout << "m_rcc_policy:               " << m_rcc_policy_name << std::endl;
 
         std::cout << "m_row_address_bits:         " << m_row_address_bits << std::endl;
         std::cout << "m_bank_address_bits:        " << m_bank_address_bits << std::endl;
@@ -249,27 +242,18 @@ class Hydra : public IControllerPlugin, public Implementation {
 
       // setup random number generator for random policy
       generator = std::mt19937(1337);
-      distribution = std::uniform_int_distribution<int>(0, 15);
+      distribution = std::uniform_int_distribution<int>(0, m_rcc_assoc - 1);
     };
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
 
       m_clk++;
       if (m_clk % m_reset_period_clk == 0) {
-        for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-          group_count_table[i].clear();
-        }
-        for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-          row_count_table[i].clear();
-        }
-        for (int i = 0; i < m_num_ranks; i++) {
-          for (int j = 0 ; j < m_rcc_set_num; j++){
-            row_count_cache[i][j].clear();
-          }
-        }
-        for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-          rct_count_table[i].clear();
-        }
+        std::fill(group_count_table.begin(), group_count_table.end(), GCT_Entry());
+        std::fill(row_count_table.begin(), row_count_table.end(), 0);
+        std::fill(rcc_tags.begin(), rcc_tags.end(), -1);
+        std::fill(rcc_counters.begin(), rcc_counters.end(), 0);
+        std::fill(rct_count_table.begin(), rct_count_table.end(), 0);
         if (m_is_debug) {
           std::cout << "----------------------------------" << std::endl;
           std::cout << "Hydra: Reset all tables (" << m_clk << ")" << std::endl;
@@ -292,6 +276,7 @@ class Hydra : public IControllerPlugin, public Implementation {
           uint rcc_index = row_id & ((1 << m_rcc_index_bits) - 1); // get least significant bits
           uint rcc_tag = row_id >> (m_row_address_bits - m_rcc_tag_row_bits) // most significant bits of row_id 
                           | bank_id << m_rcc_tag_row_bits; // bank_id
+          int rcc_set = (rank_id * m_rcc_set_num + rcc_index) * m_rcc_assoc;
 
           if (m_is_debug) {
             std::cout << "----------------------------------" << std::endl
@@ -308,17 +293,15 @@ class Hydra : public IControllerPlugin, public Implementation {
           // if the row is in the RCT rows, use RCT_count_table
           if (row_id < m_total_rct_row_size){
             // increment RCT_count_table
-            if (rct_count_table[flat_bank_id].find(row_id) == rct_count_table[flat_bank_id].end()){
-              rct_count_table[flat_bank_id][row_id] = 0;
-            }
-            rct_count_table[flat_bank_id][row_id]++;
+            int& rct_count = rct_count_table[flat_bank_id * m_total_rct_row_size + row_id];
+            rct_count++;
             if (m_is_debug) {
               std::cout << "Hydra: Row in RCT rows" << std::endl;
-              std::cout << "Hydra: RCT_count_table incremented (" << rct_count_table[flat_bank_id][row_id] << ")" << std::endl;
+              std::cout << "Hydra: RCT_count_table incremented (" << rct_count << ")" << std::endl;
             }
             // check rct_count_table
             s_rctct_check++;
-            if (rct_count_table[flat_bank_id][row_id] >= m_tracking_threshold){
+            if (rct_count >= m_tracking_threshold){
               if (m_is_debug) {
                 std::cout << "Hydra: RCT_count_table above threshold, issue VRR, reset counter" << std::endl;
               }
@@ -328,7 +311,7 @@ class Hydra : public IControllerPlugin, public Implementation {
               s_num_vrr_rct++;
               s_num_vrr++;
               // reset rcc
-              rct_count_table[flat_bank_id].erase(row_id);
+              rct_count = 0;
             } else {
               if (m_is_debug) {
                 std::cout << "Hydra: RCT_count_table below threshold, do nothing" << std::endl;
@@ -340,32 +323,28 @@ class Hydra : public IControllerPlugin, public Implementation {
           // check gct
           s_gct_check++;
 
-          if (group_count_table[flat_bank_id].find(gct_index) == group_count_table[flat_bank_id].end()) {
-            GCT_Entry new_group_entry;
-            new_group_entry.group_count = 0;
-            new_group_entry.initialized = false;
-            group_count_table[flat_bank_id][gct_index] = new_group_entry;
-          }
+          GCT_Entry& gct_entry = group_count_table[flat_bank_id * m_gct_entries_per_bank + gct_index];
+          int* bank_row_count_table = &row_count_table[(size_t) flat_bank_id * m_num_rows_per_bank];
 
-          if (group_count_table[flat_bank_id][gct_index].group_count >= m_group_threshold){
+          if (gct_entry.group_count >= m_group_threshold){
             if (m_is_debug) {
               std::cout << "Hydra: Checking GCT" << std::endl;
               std::cout << "Hydra: GCT above threshold " 
-                        << group_count_table[flat_bank_id][gct_index].group_count << std::endl;
+                        << gct_entry.group_count << std::endl;
             }
 
-            if (!group_count_table[flat_bank_id][gct_index].initialized){
+            if (!gct_entry.initialized){
               if (m_is_debug) {
                 std::cout << "Hydra: Group not initialized" << std::endl;
               }
 
               // initialize rct
-              group_count_table[flat_bank_id][gct_index].initialized = true;
+              gct_entry.initialized = true;
               s_num_initialization++;
               int row_group_start_row_id = gct_index * m_row_group_size;
               for (int i = 0; i < m_row_group_size; i++){
                 int row = row_group_start_row_id + i;
-                row_count_table[flat_bank_id][row] = m_group_threshold;
+                bank_row_count_table[row] = m_group_threshold;
               }
               // generate write request to DRAM for rct
               for (int i = 0; i < m_group_rct_cl_size; i++){
@@ -394,24 +373,29 @@ class Hydra : public IControllerPlugin, public Implementation {
             }
 
             if (m_is_debug) {
-              std::cout << "Hydra: Checking RCC[" << rank_id << "][" << rcc_index << "].size() = " << row_count_cache[rank_id][rcc_index].size() << std::endl;
-              for (auto it = row_count_cache[rank_id][rcc_index].begin(); it != row_count_cache[rank_id][rcc_index].end(); it++){
-                std::cout << "        tag: " << std::setw(6) << it->first << " counter: " << it->second << std::endl;
+              std::cout << "Hydra: Checking RCC[" << rank_id << "][" << rcc_index << "]" << std::endl;
+              for (int way = 0; way < m_rcc_assoc; way++){
+                if (rcc_tags[rcc_set + way] != -1) {
+                  std::cout << "        tag: " << std::setw(6) << rcc_tags[rcc_set + way] << " counter: " << rcc_counters[rcc_set + way] << std::endl;
+                }
               }
             }
 
             // check rcc
             s_rcc_check++;
-            if (row_count_cache[rank_id][rcc_index].find(rcc_tag) == row_count_cache[rank_id][rcc_index].end()){
+            int rcc_way = find_rcc_way(rcc_set, rcc_tag);
+            if (rcc_way == -1){
               s_num_rcc_miss++;
               if (m_is_debug) {
                 std::cout << "Hydra: RCC miss" << std::endl;
               }
               // check if rcc line is full
-              if (row_count_cache[rank_id][rcc_index].size() == 16){
+              rcc_way = find_rcc_way(rcc_set, -1);
+              if (rcc_way == -1){
                 // evicting an entry
-                int tag_to_evict = get_tag_to_evict(rank_id, rcc_index);
-                row_count_cache[rank_id][rcc_index].erase(tag_to_evict);
+                rcc_way = get_way_to_evict(rcc_set);
+                int tag_to_evict = rcc_tags[rcc_set + rcc_way];
+                rcc_tags[rcc_set + rcc_way] = -1;
                 if (m_is_debug) {
                   std::cout << "Hydra: RCC full, evicting " << tag_to_evict << std::endl;
                 }
@@ -462,8 +446,9 @@ class Hydra : public IControllerPlugin, public Implementation {
               s_num_read_req++;
 
               // insert new entry and increment rcc
-              row_count_table[flat_bank_id][row_id]++;
-              row_count_cache[rank_id][rcc_index][rcc_tag] = row_count_table[flat_bank_id][row_id];
+              bank_row_count_table[row_id]++;
+              rcc_tags[rcc_set + rcc_way] = rcc_tag;
+              rcc_counters[rcc_set + rcc_way] = bank_row_count_table[row_id];
               
               if (m_is_debug) {
                 std::cout << "Hydra: Generating read request to DRAM for RCT" << std::endl
@@ -473,8 +458,8 @@ class Hydra : public IControllerPlugin, public Implementation {
                 std::cout << "Hydra: RCC incrementing" << std::endl;
               }
             } else {
-              row_count_cache[rank_id][rcc_index][rcc_tag]++;
-              row_count_table[flat_bank_id][row_id]++;
+              rcc_counters[rcc_set + rcc_way]++;
+              bank_row_count_table[row_id]++;
               if (m_is_debug) {
                 std::cout << "Hydra: RCC hit" << std::endl;
                 std::cout << "Hydra: RCC incrementing" << std::endl;
@@ -482,11 +467,11 @@ class Hydra : public IControllerPlugin, public Implementation {
             }
 
             if (m_is_debug) {
-              std::cout << "Hydra: Checking RCC counter (" << row_count_cache[rank_id][rcc_index][rcc_tag] << ")" << std::endl;
+              std::cout << "Hydra: Checking RCC counter (" << rcc_counters[rcc_set + rcc_way] << ")" << std::endl;
             }
 
             // check if counter is above threshold
-            if (row_count_cache[rank_id][rcc_index][rcc_tag] >= m_tracking_threshold){
+            if (rcc_counters[rcc_set + rcc_way] >= m_tracking_threshold){
               if (m_is_debug) {
                 std::cout << "Hydra: RCC above threshold, issue VRR, reset counter" << std::endl;
               }
@@ -495,8 +480,8 @@ class Hydra : public IControllerPlugin, public Implementation {
               m_ctrl->priority_send(vrr_req);
               s_num_vrr++;
               // reset rcc
-              row_count_cache[rank_id][rcc_index][rcc_tag] = 0;
-              row_count_table[flat_bank_id][row_id] = 0;
+              rcc_counters[rcc_set + rcc_way] = 0;
+              bank_row_count_table[row_id] = 0;
             } else {
               if (m_is_debug) {
                 std::cout << "Hydra: RCC below threshold, do nothing" << std::endl;
@@ -506,10 +491,10 @@ class Hydra : public IControllerPlugin, public Implementation {
           else{
             if (m_is_debug) {
               std::cout << "Hydra: Checking GCT" << std::endl;
-              std::cout << "Hydra: GCT below threshold (" << group_count_table[flat_bank_id][gct_index].group_count << ")" << std::endl;
+              std::cout << "Hydra: GCT below threshold (" << gct_entry.group_count << ")" << std::endl;
               std::cout << "Hydra: GCT incrementing" << std::endl;
             }
-            group_count_table[flat_bank_id][gct_index].group_count++;
+            gct_entry.group_count++;
           }
         }
       }
@@ -522,27 +507,33 @@ class Hydra : public IControllerPlugin, public Implementation {
       return std::make_pair(rct_row_id, rct_col_id);
     };
 
-    int get_tag_to_evict(int rank_id, int rcc_index) {
-      int tag_to_evict = -1;
-
-      if (m_rcc_policy == "RANDOM") {
-        int tag_index = distribution(generator);
-        auto it = row_count_cache[rank_id][rcc_index].begin();
-        std::advance(it, tag_index);
-        tag_to_evict = it->first;
-      } else if (m_rcc_policy == "MIN_COUNT") {
-        int min_count = INT_MAX;
-        for (auto it = row_count_cache[rank_id][rcc_index].begin(); it != row_count_cache[rank_id][rcc_index].end(); it++) {
-          if (it->second < min_count) {
-            min_count = it->second;
-            tag_to_evict = it->first;
-          }
+    // returns the way of the rcc set that holds the tag, or -1 if the tag is not in the set
+    int find_rcc_way(int rcc_set, int tag) {
+      const int* set_tags = &rcc_tags[rcc_set];
+      for (int way = 0; way < m_rcc_assoc; way++) {
+        if (set_tags[way] == tag) {
+          return way;
+        }
+      }
+      return -1;
+    };
+
+    int get_way_to_evict(int rcc_set) {
+      int way_to_evict = -1;
+
+      switch (m_rcc_policy) {
+        case RCCPolicy::RANDOM: {
+          way_to_evict = distribution(generator);
+          break;
+        }
+        case RCCPolicy::MIN_COUNT: {
+          const int* set_counters = &rcc_counters[rcc_set];
+          way_to_evict = std::min_element(set_counters, set_counters + m_rcc_assoc) - set_counters;
+          break;
         }
-      } else {
-        throw ConfigurationError("Undefined RCC eviction policy.");
       }
 
-      return tag_to_evict;
+      return way_to_evict;
     };
 
     void reserve_rows_for_rct() {
@@ -1,6 +1,5 @@
 #include <vector>
 #include <deque>
-#include <unordered_map>
 #include <limits>
 #include <random>
 
@@ -16,8 +15,13 @@ class OracleRH : public IControllerPlugin, public Implementation {
   private:
     IDRAM* m_dram = nullptr;
 
-    using BankACTCounter = std::unordered_map<Addr_t, int>;
-    std::vector<BankACTCounter> m_table;
+    // per bank activation counter of every row (16 bits, the counters never exceed tRH)
+    // indexed using flattened <rank id, bank id>, then the row id
+    std::vector<uint16_t> m_counters;
+    // per bank rows activated since the last refresh, so that a refresh only clears their counters
+    std::vector<std::vector<int>> m_activated_rows;
+    // whether each row is in m_activated_rows (its counter drops back to 0 on a VRR, so the counter cannot tell)
+    std::vector<bool> m_is_activated;
 
     int m_RH_threshold = -1;
 
@@ -37,6 +41,10 @@ class OracleRH : public IControllerPlugin, public Implementation {
     void init() override { 
       m_is_debug = param<bool>("debug").default_val(false);
       m_RH_threshold = param<int>("tRH").required();
+
+      if (m_RH_threshold <= 0 || m_RH_threshold > std::numeric_limits<uint16_t>::max()) {
+        throw ConfigurationError("[OracleRH] tRH ({}) must be in [1, {}]!", m_RH_threshold, std::numeric_limits<uint16_t>::max());
+      }
     };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -59,7 +67,9 @@ class OracleRH : public IControllerPlugin, public Implementation {
                              m_dram->get_level_size("bankgroup") * m_dram->get_level_size("bank");
       m_num_rows_per_bank = m_dram->get_level_size("row");
 
-      m_table.resize(m_num_banks_per_rank * m_num_ranks);
+      m_counters.resize((size_t) m_num_banks_per_rank * m_num_ranks * m_num_rows_per_bank, 0);
+      m_is_activated.resize(m_counters.size(), false);
+      m_activated_rows.resize(m_num_banks_per_rank * m_num_ranks);
     };
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
@@ -76,22 +86,29 @@ class OracleRH : public IControllerPlugin, public Implementation {
           }
           
           int row_id = req_it->addr_vec[m_row_level];
-          if (m_table[flat_bank_id].find(row_id) != m_table[flat_bank_id].end()) {
-            m_table[flat_bank_id][row_id]++;
-            if (m_table[flat_bank_id][row_id] >= m_RH_threshold) {
-              m_table[flat_bank_id][row_id] = 0;
-              Request vrr_req(req_it->addr_vec, m_VRR_req_id);
-              m_ctrl->priority_send(vrr_req);
-            }
-          } else {
-            m_table[flat_bank_id][row_id] = 1;
+          size_t flat_row_id = (size_t) flat_bank_id * m_num_rows_per_bank + row_id;
+          uint16_t& counter = m_counters[flat_row_id];
+          if (!m_is_activated[flat_row_id]) {
+            m_is_activated[flat_row_id] = true;
+            m_activated_rows[flat_bank_id].push_back(row_id);
+          }
+          counter++;
+          if (counter >= m_RH_threshold) {
+            counter = 0;
+            Request vrr_req(req_it->addr_vec, m_VRR_req_id);
+            m_ctrl->priority_send(vrr_req);
           }
         } else if (
           m_dram->m_command_meta(req_it->command).is_refreshing && 
           m_dram->m_command_scopes(req_it->command) == m_rank_level) {
             int rank_id = req_it->addr_vec[m_rank_level];
             for (int i = rank_id * m_num_banks_per_rank; i < (rank_id + 1) * m_num_banks_per_rank; i++) {
-              m_table[i].clear();
+              size_t bank_offset = (size_t) i * m_num_rows_per_bank;
+              for (int row_id : m_activated_rows[i]) {
+                m_counters[bank_offset + row_id] = 0;
+                m_is_activated[bank_offset + row_id] = false;
+              }
+              m_activated_rows[i].clear();
             }
         }
       }
@@ -0,0 +1,127 @@
+#include <vector>
+#include <filesystem>
+#include <fstream>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/plugin.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Records the energy and average power of every rank of the channel each epoch.
+ * @details
+ * Every epoch cycles, one record per rank is written to {path}.ch{channel_id} with the background and command
+ * energy (nJ) the rank consumed during the epoch and its average power (mW). The energy is computed incrementally
+ * from the power stats of the DRAM (cycles spent in each power state and issued commands), so the DRAM power model
+ * (drampower_enable) must be enabled. Only complete epochs are recorded.
+ *
+ * In the "csv" format, each record is a line "cycle, rank, background_energy, cmd_energy, energy, power".
+ * In the "binary" format, each record is the int64 cycle, the int32 rank and the four values as doubles.
+ */
+class PowerRecorder : public IControllerPlugin, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IControllerPlugin, PowerRecorder, "PowerRecorder", "Records the per-rank energy and power time series.")
+  private:
+    IDRAM* m_dram = nullptr;
+
+    std::filesystem::path m_save_path;
+    std::ofstream m_output;
+    bool m_binary = false;
+    Clk_t m_epoch = -1;
+
+    Clk_t m_clk = 0;
+    double m_epoch_ns = 0;
+
+    int m_num_ranks = -1;   // Number of ranks in the channel
+    int m_first_rank = -1;  // Index of the first rank of the channel in the DRAM power stats
+    std::vector<double> m_last_background_energy;
+    std::vector<double> m_last_cmd_energy;
+
+  public:
+    void init() override {
+      m_save_path = param<std::string>("path").desc("Path to the power trace file").required();
+      m_epoch = param<Clk_t>("epoch").desc("Number of cycles between two records").default_val(10000);
+      std::string format = param<std::string>("format").desc("Format of the power trace (csv or binary)").default_val("csv");
+
+      if (m_epoch <= 0) {
+        throw ConfigurationError("Invalid epoch length ({}) for the power recorder!", m_epoch);
+      }
+      if (format == "binary") {
+        m_binary = true;
+      } else if (format != "csv") {
+        throw ConfigurationError("Unrecognized power trace format \"{}\" (csv or binary)!", format);
+      }
+
+      auto parent_path = m_save_path.parent_path();
+      std::filesystem::create_directories(parent_path);
+      if (!(std::filesystem::exists(parent_path) && std::filesystem::is_directory(parent_path))) {
+        throw ConfigurationError("Invalid path to trace file: {}", parent_path.string());
+      }
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_ctrl = cast_parent<IDRAMController>();
+      m_dram = m_ctrl->m_dram;
+
+      if (!m_dram->m_drampower_enable) {
+        throw ConfigurationError("[PowerRecorder] The power model of {} (drampower_enable) is not enabled!", m_dram->get_name());
+      }
+
+      m_num_ranks = m_dram->m_power_stats.size() / m_dram->get_level_size("channel");
+      m_first_rank = m_ctrl->m_channel_id * m_num_ranks;
+      m_last_background_energy.resize(m_num_ranks, 0);
+      m_last_cmd_energy.resize(m_num_ranks, 0);
+      m_epoch_ns = m_epoch * m_dram->m_timing_vals("tCK_ps") / 1000.0;
+
+      auto path = fmt::format("{}.ch{}", m_save_path.string(), m_ctrl->m_channel_id);
+      m_output.open(path, m_binary ? std::ios::out | std::ios::binary : std::ios::out);
+      if (!m_output.is_open()) {
+        throw ConfigurationError("Cannot open power trace file {}!", path);
+      }
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      m_clk++;
+
+      if (m_clk % m_epoch == 0) {
+        record();
+      }
+    };
+
+    void finalize() override {
+      m_output.close();
+    };
+
+  private:
+    void record() {
+      for (int rank = 0; rank < m_num_ranks; rank++) {
+        const PowerStats& rank_stats = m_dram->m_power_stats[m_first_rank + rank];
+        double background_energy = m_dram->get_rank_background_energy(rank_stats);
+        double cmd_energy = m_dram->get_rank_cmd_energy(rank_stats);
+
+        double epoch_background_energy = background_energy - m_last_background_energy[rank];
+        double epoch_cmd_energy = cmd_energy - m_last_cmd_energy[rank];
+        double epoch_energy = epoch_background_energy + epoch_cmd_energy;
+        // nJ / ns = W
+        double power = epoch_energy / m_epoch_ns * 1E3;
+
+        m_last_background_energy[rank] = background_energy;
+        m_last_cmd_energy[rank] = cmd_energy;
+
+        if (m_binary) {
+          int64_t clk = m_clk;
+          int32_t rank_id = m_first_rank + rank;
+          m_output.write(reinterpret_cast<const char*>(&clk), sizeof(clk));
+          m_output.write(reinterpret_cast<const char*>(&rank_id), sizeof(rank_id));
+          for (double val : {epoch_background_energy, epoch_cmd_energy, epoch_energy, power}) {
+            m_output.write(reinterpret_cast<const char*>(&val), sizeof(val));
+          }
+        } else {
+          m_output << fmt::format("{}, {}, {}, {}, {}, {}", m_clk, m_first_rank + rank,
+                                  epoch_background_energy, epoch_cmd_energy, epoch_energy, power) << "\n";
+        }
+      }
+    };
+};
+
+}       // namespace Ramulator
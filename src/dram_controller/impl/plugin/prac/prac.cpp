@@ -6,9 +6,7 @@
 
 #include <limits>
 #include <vector>
-#include <functional>
-#include <unordered_map>
-#include <unordered_set>
+#include <algorithm>
 
 namespace Ramulator {
 
@@ -35,6 +33,11 @@ private:
 
     int m_abo_act_cycles = -1;
 
+    int m_cmd_prea = -1;
+    int m_cmd_rfmab = -1;
+    int m_cmd_rfmsb = -1;
+    int m_cmd_act = -1;
+
     uint32_t m_abo_recov_rem_refs = -1;
     uint32_t m_abo_delay_rem_acts = -1;
     bool m_is_abo_needed = false;
@@ -50,6 +53,11 @@ public:
         m_abo_recovery_refs = param<int>("abo_recovery_refs").default_val(4);
         m_abo_act_ns = param<int>("abo_act_ns").default_val(180);
         m_abo_thresh = param<int>("abo_threshold").default_val(512);
+
+        if (m_abo_thresh <= 0 || m_abo_thresh > std::numeric_limits<PerBankCounters::Counter_t>::max()) {
+            throw ConfigurationError("[PRAC] The ABO threshold ({}) must be in [1, {}]!",
+                                     m_abo_thresh, std::numeric_limits<PerBankCounters::Counter_t>::max());
+        }
     }
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
@@ -59,6 +67,11 @@ public:
         m_is_abo_needed = false;
         m_abo_act_cycles = m_abo_act_ns / ((float) m_cfg.m_dram->m_timing_vals("tCK_ps") / 1000.0f);
 
+        m_cmd_prea = m_cfg.m_dram->m_commands("PREA");
+        m_cmd_rfmab = m_cfg.m_dram->m_commands("RFMab");
+        m_cmd_rfmsb = m_cfg.m_dram->m_commands("RFMsb");
+        m_cmd_act = m_cfg.m_dram->m_commands("ACT");
+
         m_bank_counters.reserve(m_cfg.m_num_banks);
         for (int i = 0; i < m_cfg.m_num_banks; i++) {
             m_bank_counters.emplace_back(i, m_cfg, m_is_abo_needed, m_abo_thresh, m_debug);
@@ -110,23 +123,23 @@ public:
         }
     }
 
+    static const char* state_name(ABOState state) {
+        switch (state) {
+        case ABOState::NORMAL:          return "ABOState::NORMAL";
+        case ABOState::PRE_RECOVERY:    return "ABOState::PRE_RECOVERY";
+        case ABOState::RECOVERY:        return "ABOState::RECOVERY";
+        case ABOState::DELAY:           return "ABOState::DELAY";
+        }
+        return "";
+    }
+
     void update_state_machine(bool request_found, const Request& req) {
-        std::unordered_map<ABOState, std::string> state_names = {
-            {ABOState::NORMAL, "ABOState::NORMAL"},
-            {ABOState::PRE_RECOVERY, "ABOState::PRE_RECOVERY"},
-            {ABOState::RECOVERY, "ABOState::RECOVERY"},
-            {ABOState::DELAY, "ABOState::DELAY"}
-        };
-        auto cmd_prea = m_cfg.m_dram->m_commands("PREA");
-        auto cmd_rfmab = m_cfg.m_dram->m_commands("RFMab");
-        auto cmd_rfmsb = m_cfg.m_dram->m_commands("RFMsb");
-        auto cmd_act = m_cfg.m_dram->m_commands("ACT");
         auto cur_state = m_state;
         switch(m_state) {
         case ABOState::NORMAL:
             if (m_is_abo_needed) {
                 if (m_debug) {
-                    std::printf("[PRAC] [%lu] <%s> Asserting ALERT_N.\n", m_clk, state_names[cur_state].c_str());
+                    std::printf("[PRAC] [%lu] <%s> Asserting ALERT_N.\n", m_clk, state_name(cur_state));
                 }
                 m_state = ABOState::PRE_RECOVERY;
                 m_abo_recovery_start = m_clk + m_abo_act_cycles;
@@ -134,9 +147,9 @@ public:
             }
             break;
         case ABOState::PRE_RECOVERY:
-            if (request_found && req.command == cmd_prea) {
+            if (request_found && req.command == m_cmd_prea) {
                 if (m_debug) {
-                    std::printf("[PRAC] [%lu] <%s> Received PREA.\n", m_clk, state_names[cur_state].c_str());
+                    std::printf("[PRAC] [%lu] <%s> Received PREA.\n", m_clk, state_name(cur_state));
                 }
             }
             if (m_clk == m_abo_recovery_start) {
@@ -146,8 +159,8 @@ public:
             }
             break;
         case ABOState::RECOVERY:
-            if (request_found && (req.command == cmd_rfmab ||
-                req.command == cmd_rfmsb)) {
+            if (request_found && (req.command == m_cmd_rfmab ||
+                req.command == m_cmd_rfmsb)) {
                 m_abo_recov_rem_refs--;
                 if (!m_abo_recov_rem_refs) {
                     m_state = ABOState::DELAY;
@@ -156,7 +169,7 @@ public:
             }
             break;
         case ABOState::DELAY:
-            if (request_found && req.command == cmd_act) {
+            if (request_found && req.command == m_cmd_act) {
                 m_abo_delay_rem_acts--;
                 if (!m_abo_delay_rem_acts) {
                     m_is_abo_needed = false;
@@ -169,7 +182,7 @@ public:
             break;
         }
         if (m_debug && cur_state != m_state) {
-            std::printf("[PRAC] [%lu] <%s> -> <%s>\n", m_clk, state_names[cur_state].c_str(), state_names[m_state].c_str());
+            std::printf("[PRAC] [%lu] <%s> -> <%s>\n", m_clk, state_name(cur_state), state_name(m_state));
         }
     }
 
@@ -186,62 +199,82 @@ public:
     }
 
 private:
+    /**
+     * @brief    The activation counter of every row of a bank.
+     * @details
+     * The counters are a dense array of 16-bit saturating counters indexed by the row address, so the memory is bounded
+     * by the number of rows and a lookup is a single access. The rows with a non-zero counter and the critical rows (i.e.,
+     * those with a counter at or above the ABO threshold) are also listed, so that resets and RFMs only visit the rows
+     * activated since the last reset instead of the whole bank.
+     */
     class PerBankCounters {
     public: 
+        using Counter_t = uint16_t;
+
         PerBankCounters(int bank_id, DeviceConfig& cfg, bool& is_abo_needed, int alert_thresh, bool debug)
         : m_bank_id(bank_id), m_cfg(cfg), m_is_abo_needed(is_abo_needed),
         m_alert_thresh(alert_thresh), m_debug(debug) {
             init_dram_params(m_cfg.m_dram);
+            m_counters.resize(m_cfg.m_num_rows_per_bank);
             reset();
         }
 
-        ~PerBankCounters() {
-            m_counters.clear();
-        }
-
         void on_request(const Request& req) {
-            if (m_handlertable.find(req.command) != m_handlertable.end()) {
-                m_handlertable[req.command].handler(req);
+            switch (m_handlers[req.command]) {
+            case Handler::ACT:
+                process_act(req);
+                break;
+            case Handler::RFM:
+                process_rfm(req);
+                break;
+            default:
+                break;
             }
         }
 
         void init_dram_params(IDRAM* dram) {
-            CommandHandler handlers[] = {
-                // TODO: We should process PREs? Doesn't really change the results though.
-                {std::string("ACT"), std::bind(&PerBankCounters::process_act, this, std::placeholders::_1)},
-                {std::string("RFMab"), std::bind(&PerBankCounters::process_rfm, this, std::placeholders::_1)},
-                {std::string("RFMsb"), std::bind(&PerBankCounters::process_rfm, this, std::placeholders::_1)}
+            // TODO: We should process PREs? Doesn't really change the results though.
+            std::pair<std::string, Handler> handlers[] = {
+                {"ACT", Handler::ACT},
+                {"RFMab", Handler::RFM},
+                {"RFMsb", Handler::RFM}
             };
-            for (auto& h : handlers) {
-                if (!dram->m_commands.contains(h.cmd_name)) {
-                    std::cout << "[PRAC] Command " << h.cmd_name << "does not exist." << std::endl;
+            m_handlers.assign(dram->m_commands.size(), Handler::NONE);
+            for (auto& [cmd_name, handler] : handlers) {
+                if (!dram->m_commands.contains(cmd_name)) {
+                    std::cout << "[PRAC] Command " << cmd_name << "does not exist." << std::endl;
                     exit(0);
                 }
-                m_handlertable[dram->m_commands(h.cmd_name)] = h;
+                m_handlers[dram->m_commands(cmd_name)] = handler;
             }
         }
 
         void reset() {
-            m_counters.clear();
+            for (int row : m_touched_rows) {
+                m_counters[row] = 0;
+            }
+            m_touched_rows.clear();
             m_critical_rows.clear();
         }
 
         bool is_critical() {
-            return m_critical_rows.size() > 0;
+            return !m_critical_rows.empty();
         }
 
     private:
-        struct CommandHandler {
-            std::string cmd_name;
-            std::function<void(const Request&)> handler;
+        enum class Handler : uint8_t {
+            NONE,
+            ACT,
+            RFM
         };
 
         DeviceConfig& m_cfg;
         bool& m_is_abo_needed;
 
-        std::unordered_map<int, uint32_t> m_counters;
-        std::unordered_map<int, uint32_t> m_critical_rows;
-        std::unordered_map<int, CommandHandler> m_handlertable;
+        std::vector<Counter_t> m_counters;
+        std::vector<int> m_touched_rows;      // Rows with a non-zero counter
+        std::vector<int> m_critical_rows;     // Rows with a counter at or above the alert threshold
+        std::vector<Handler> m_handlers;    // Indexed by command id
 
         int m_alert_thresh = -1;
         bool m_debug = false;
@@ -249,37 +282,52 @@ private:
 
         void process_act(const Request& req) {
             auto row_addr = req.addr_vec[m_cfg.m_row_level];    
-            if (m_counters.find(row_addr) == m_counters.end()) {
-                m_counters[row_addr] = 0;
+            Counter_t& counter = m_counters[row_addr];
+            if (counter < std::numeric_limits<Counter_t>::max()) {
+                if (counter == 0) {
+                    m_touched_rows.push_back(row_addr);
+                }
+                counter++;
+                if (counter == m_alert_thresh) {
+                    m_critical_rows.push_back(row_addr);
+                }
             }
-            m_counters[row_addr]++;
             if (m_debug) {
                 std::printf("[PRAC] [%d] [ACT] Row: %d Act: %u\n",
-                    m_bank_id, row_addr, m_counters[row_addr]);
+                    m_bank_id, row_addr, counter);
             }
-            if (m_counters[row_addr] >= m_alert_thresh) {
-                m_critical_rows[row_addr] = m_counters[row_addr];
+            if (counter >= m_alert_thresh) {
                 m_is_abo_needed = true;
             }
         }
 
         void process_rfm(const Request& req) {
-            auto act_max = std::max_element(m_counters.begin(), m_counters.end(),
-                [] (const std::pair<int, uint32_t>& p1, const std::pair<int, uint32_t>& p2) {
-                    return p1.second < p2.second;
-                });
-            if (act_max == m_counters.end()) {
+            if (m_touched_rows.empty()) {
                 if (m_debug) {
                     std::printf("[PRAC] [%d] [RFM] No critical row.\n", m_bank_id);
                 }
                 return;
             }
+            // The most activated row (the lowest one on a tie) is critical if any row is
+            bool is_victim_critical = !m_critical_rows.empty();
+            auto& candidates = is_victim_critical ? m_critical_rows : m_touched_rows;
+            auto victim_it = std::min_element(candidates.begin(), candidates.end(), [this](int a, int b) {
+                return m_counters[a] > m_counters[b] || (m_counters[a] == m_counters[b] && a < b);
+            });
+            int victim_row = *victim_it;
             if (m_debug) {
                 std::printf("[PRAC] [%d] [RFM] Row: %d Act: %u\n",
-                    m_bank_id, act_max->first, m_counters[act_max->first]);
+                    m_bank_id, victim_row, m_counters[victim_row]);
+            }
+
+            m_counters[victim_row] = 0;
+            if (is_victim_critical) {
+                *victim_it = m_critical_rows.back();
+                m_critical_rows.pop_back();
+                victim_it = std::find(m_touched_rows.begin(), m_touched_rows.end(), victim_row);
             }
-            m_counters[act_max->first] = 0;
-            m_critical_rows.erase(act_max->first);
+            *victim_it = m_touched_rows.back();
+            m_touched_rows.pop_back();
         }
     };  // class PerBankCounters
 
@@ -3,7 +3,7 @@
 
 #include "dram/dram.h"
 
-#include <unordered_map>
+#include <vector>
 
 #define _CYCLES(timing_name)    dram->m_timing_vals(timing_name)
 #define _COMMAND(command_name)  dram->m_commands(command_name)
@@ -28,6 +28,7 @@ public:
         auto write_to_pre_timing = _CYCLES("nCWL") + _CYCLES("nBL") + _CYCLES("nWR");
         read_cycles = _CYCLES("nRAS") + _CYCLES("nRTP") + _CYCLES("nRP");
         write_cycles = _CYCLES("nRAS") + write_to_pre_timing + _CYCLES("nRP");
+        cmd_to_min_cycles.assign(dram->m_commands.size(), 0);
         cmd_to_min_cycles[_COMMAND("ACT")] = write_cycles; // TODO: Slightly overshooting reads here
         cmd_to_min_cycles[_COMMAND("RD")] = _CYCLES("nRTP") + _CYCLES("nRP");
         cmd_to_min_cycles[_COMMAND("WR")] = write_to_pre_timing + _CYCLES("nRP");
@@ -43,14 +44,11 @@ public:
     }
 
     int min_cycles_with_preall(const Request& req) {
-        if (cmd_to_min_cycles.find(req.command) == cmd_to_min_cycles.end()) {
-            return 0;
-        }
         return cmd_to_min_cycles[req.command];
     }
 
 private:
-    std::unordered_map<int, int> cmd_to_min_cycles;
+    std::vector<int> cmd_to_min_cycles;     // Indexed by command id, 0 for the commands without a constraint
     int write_cycles = -1;
     int read_cycles = -1;
 
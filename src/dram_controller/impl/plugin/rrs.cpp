@@ -1,11 +1,11 @@
 #include <vector>
-#include <unordered_map>
 #include <limits>
 #include <random>
 
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
+#include "dram_controller/impl/plugin/activation_tracker/activation_tracker.h"
 #include "addr_mapper/impl/rit.h"
 
 namespace Ramulator {
@@ -39,13 +39,11 @@ class RRS : public IControllerPlugin, public Implementation {
     int m_num_rows_per_bank = -1;
     int m_num_cls = -1;
 
-    // per bank hot-row tracker (same as Graphene)
+    // per bank hot-row tracker (same as Graphene, with its spillover counter)
     // indexed using flattened <rank id, bank id>
     // e.g., if rank 0, bank 4, index is 4
     // if rank 1, bank 5, index is 16 (assuming 16 banks/rank) + 5
-    std::vector<std::unordered_map<int, int>> m_hot_row_tracker;
-    // spillover counter per bank
-    std::vector<int> m_spillover_counter;
+    std::vector<ActivationTracker<>> m_hot_row_tracker;
     // per bank row indirection table is implemented in 'src/addr_mapper/impl/linear_mappers_with_rit.cpp'
     
     // rng
@@ -89,12 +87,7 @@ class RRS : public IControllerPlugin, public Implementation {
       m_num_cls = m_dram->get_level_size("column") / 8;
 
       // Initialize hot-row tracker
-      for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-        std::unordered_map<int, int> table;
-        m_hot_row_tracker.push_back(table);
-      }
-      // Initialize spillover counter
-      m_spillover_counter = std::vector<int>(m_num_banks_per_rank * m_num_ranks, 0);
+      m_hot_row_tracker.resize(m_num_banks_per_rank * m_num_ranks, ActivationTracker<>(m_num_hrt_entries, false));
       // Initialize row indirection table in the addr_mapper
       m_addr_mapper->init_rit(m_num_banks_per_rank * m_num_ranks, m_num_rit_entries);
       
@@ -124,11 +117,10 @@ class RRS : public IControllerPlugin, public Implementation {
 
       if (m_clk % m_reset_period_clk == 0) {
         // Reset hrt and unlock rit
-        for (int i = 0; i < m_num_banks_per_rank * m_num_ranks; i++) {
-          m_hot_row_tracker[i].clear();
-          m_spillover_counter[i] = 0;
-          m_addr_mapper->rit_unlock();
+        for (auto& hrt : m_hot_row_tracker) {
+          hrt.clear();
         }
+        m_addr_mapper->rit_unlock();
         if (m_is_debug) {
           std::cout << "----------------------------" << std::endl;
           std::cout << "RRS is resetting. " << m_clk << std::endl;
@@ -155,73 +147,39 @@ class RRS : public IControllerPlugin, public Implementation {
           }
 
           // Check HRT
-          if (m_hot_row_tracker[flat_bank_id].find(row_id) == m_hot_row_tracker[flat_bank_id].end()) {
+          ActivationTracker<>& hrt = m_hot_row_tracker[flat_bank_id];
+          int entry = hrt.find(row_id);
+          if (entry == -1) {
             if (m_is_debug) {
               std::cout << "  └  " << "row " << row_id << " not in HRT." << std::endl;
             }
-            // if row is not in the table, check if the table is full 
-            if (m_hot_row_tracker[flat_bank_id].size() < m_num_hrt_entries) {
+            // if row is not in the table, insert it if the table is not full,
+            // otherwise replace a row whose count equals the spillover counter
+            entry = hrt.insert(row_id);
+            if (entry == -1) {
               if (m_is_debug) {
-                std::cout << "  └  " << "HRT is not full, inserting with count 1." << std::endl;
-              }
-              // if table is not full, insert the row
-              m_hot_row_tracker[flat_bank_id][row_id] = 1;
-            } else {
-              if (m_is_debug) {
-                std::cout << "  └  " << "HRT is full, searching for a row to evict." << std::endl;
-              }
-              // if table is full, find a row to evict
-              bool found = false;
-              int to_remove = -1;
-              int spillover_value = -1;
-
-              for (auto it = m_hot_row_tracker[flat_bank_id].begin(); it != m_hot_row_tracker[flat_bank_id].end(); it++) {
-                // if we find an entry with spillover counter value, evict it
-                if (it->second == m_spillover_counter[flat_bank_id]) {
-                  if (m_is_debug) {
-                    std::cout << "  └  " << "found a row to evict: " << it->first << std::endl;
-                  }
-                  // if we find an entry, record it
-                  spillover_value = it->second;
-                  to_remove = it->first;
-                  found = true;
-                  break;
-                }
-              }
-
-              if (found) {
-                if (m_is_debug) {
-                  std::cout << "Removing row " << to_remove << " from HRT." << std::endl;
-                  std::cout << "Adding row " << row_id << " to HRT." << std::endl;
-                }
-                // remove to_remove from the table
-                m_hot_row_tracker[flat_bank_id].erase(to_remove);
-                // add row_id to the table
-                m_hot_row_tracker[flat_bank_id][row_id] = spillover_value + 1;
-              }
-              else {
-                if (m_is_debug) {
-                  std::cout << "  └  " << "no row to evict, incrementing spillover counter." << std::endl;
-                }
-                m_spillover_counter[flat_bank_id] += 1;
-                return;
+                std::cout << "  └  " << "no row to evict, incrementing spillover counter." << std::endl;
               }
+              return;
+            }
+            if (m_is_debug) {
+              std::cout << "Adding row " << row_id << " to HRT." << std::endl;
             }
           } else {
             if (m_is_debug) { 
               std::cout << "  └  " << "row " << row_id << " in HRT. Incrementing its counter." << std::endl;
             }
             // if row in table, increment its activation count
-            m_hot_row_tracker[flat_bank_id][row_id] += 1;
+            hrt.count(entry) += 1;
           }
           // dump HRT for debug
           if (m_is_debug) {
             std::cout << "==========================" << std::endl;
-            std::cout << "HRT[" << flat_bank_id << "].size(): " << m_hot_row_tracker[flat_bank_id].size() << std::endl;
-            for (auto entry: m_hot_row_tracker[flat_bank_id]) {
-              std::cout << entry.first << ":\t" << entry.second << std::endl; 
+            std::cout << "HRT[" << flat_bank_id << "].size(): " << hrt.size() << std::endl;
+            for (int i = 0; i < hrt.size(); i++) {
+              std::cout << hrt.row(i) << ":\t" << hrt.count(i) << std::endl; 
             }
-            std::cout << "Spillover counter: " << m_spillover_counter[flat_bank_id] << std::endl;
+            std::cout << "Spillover counter: " << hrt.spillover() << std::endl;
             std::cout << "==========================" << std::endl;
           }
 
@@ -229,9 +187,9 @@ class RRS : public IControllerPlugin, public Implementation {
           if (m_is_debug) {
             std::cout << "Row " << row_id << " in HRT" << std::endl;
             std::cout << "  └  " << "threshold: " << m_rss_threshold << std::endl;
-            std::cout << "  └  " << "count: " << m_hot_row_tracker[flat_bank_id][row_id] << std::endl;
+            std::cout << "  └  " << "count: " << hrt.count(entry) << std::endl;
           }
-          if (m_hot_row_tracker[flat_bank_id][row_id] % m_rss_threshold == 0) {
+          if (hrt.count(entry) % m_rss_threshold == 0) {
             if (m_is_debug) {
               std::cout << "Row " << row_id << " needs swapping!" << std::endl;
             }
@@ -249,7 +207,7 @@ class RRS : public IControllerPlugin, public Implementation {
                 // check if rit has empty slots
                 if (m_addr_mapper->is_rit_full(flat_bank_id)) {
                   // if rit is full, get a pair to unswap
-                  auto unswap_pair = m_addr_mapper->get_unswap_pair(flat_bank_id, m_hot_row_tracker[flat_bank_id]);
+                  auto unswap_pair = m_addr_mapper->get_unswap_pair(flat_bank_id, [&hrt](int row) { return hrt.find(row) != -1; });
                   if (m_is_debug) {
                     std::cout << "RIT is full." << std::endl;
                     std::cout << "Unswapping row " << unswap_pair.first << " with row " << unswap_pair.second << std::endl;
@@ -312,7 +270,7 @@ class RRS : public IControllerPlugin, public Implementation {
               // check if rit has empty slots
               if (m_addr_mapper->is_rit_full(flat_bank_id)) {
                 // if rit is full, get a pair to unswap
-                auto unswap_pair = m_addr_mapper->get_unswap_pair(flat_bank_id, m_hot_row_tracker[flat_bank_id]);
+                auto unswap_pair = m_addr_mapper->get_unswap_pair(flat_bank_id, [&hrt](int row) { return hrt.find(row) != -1; });
                 if (m_is_debug) {
                   std::cout << "RIT is full." << std::endl;
                   std::cout << "Unswapping row " << unswap_pair.first << " with row " << unswap_pair.second << std::endl;
@@ -352,7 +310,7 @@ class RRS : public IControllerPlugin, public Implementation {
       while (dst_row == -1) {
         int rand_row = distribution(generator);
         // check if rand row is in hrt or is in rit or is not row_id 
-        if (m_hot_row_tracker[bank_id].find(rand_row) == m_hot_row_tracker[bank_id].end() 
+        if (m_hot_row_tracker[bank_id].find(rand_row) == -1 
             && m_addr_mapper->check_rit(bank_id, rand_row) == -1
             && rand_row != row_id) {
           dst_row = rand_row;
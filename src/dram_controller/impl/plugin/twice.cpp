@@ -1,11 +1,11 @@
 #include <vector>
-#include <unordered_map>
 #include <limits>
 #include <random>
 
 #include "base/base.h"
 #include "dram_controller/controller.h"
 #include "dram_controller/plugin.h"
+#include "dram_controller/impl/plugin/activation_tracker/activation_tracker.h"
 
 namespace Ramulator {
 
@@ -15,15 +15,6 @@ class TWiCeIdeal : public IControllerPlugin, public Implementation {
   private:
     IDRAM* m_dram = nullptr;
 
-    struct TwiCeEntry {
-      int act_count;
-      int life;
-      TwiCeEntry():
-        act_count(-1), life(-1) {};
-      TwiCeEntry(int a, int l):
-        act_count(a), life(l) {};
-    };
-
     Clk_t m_clk = 0;
 
     int m_twice_rh_threshold = -1;
@@ -40,11 +31,11 @@ class TWiCeIdeal : public IControllerPlugin, public Implementation {
     int m_num_banks_per_rank = -1;
     int m_num_rows_per_bank = -1;
     
-    // per bank twice table
+    // per bank twice table (the counter of each entry is its act count, the data its life)
     // indexed using flattened <rank id, bank id>
     // e.g., if rank 0, bank 4, index is 4
     // if rank 1, bank 5, index is 16 (assuming 16 banks/rank) + 5
-    std::vector<std::unordered_map<Addr_t, TwiCeEntry>> m_twice_table;
+    std::vector<ActivationTracker<int>> m_twice_table;
 
   public:
     void init() override { 
@@ -74,10 +65,8 @@ class TWiCeIdeal : public IControllerPlugin, public Implementation {
       m_num_rows_per_bank = m_dram->get_level_size("row");
 
       // Initialize twice table
-      for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-        std::unordered_map<Addr_t, TwiCeEntry> bank_twice_table;
-        m_twice_table.push_back(bank_twice_table);
-      }
+      // (idealized: the table grows so that every activated row has an entry)
+      m_twice_table.resize(m_num_ranks * m_num_banks_per_rank, ActivationTracker<int>(256, true));
     };
 
     void update(bool request_found, ReqBuffer::iterator& req_it) override {
@@ -92,25 +81,22 @@ class TWiCeIdeal : public IControllerPlugin, public Implementation {
             std::cout << "TWiCeIdeal: Refresh command" << std::endl;
           }
           for (int i = 0; i < m_num_ranks * m_num_banks_per_rank; i++) {
-            std::vector<std::unordered_map<Addr_t, TwiCeEntry>::iterator> to_be_pruned;
-            for (auto it = m_twice_table[i].begin(); it != m_twice_table[i].end(); it++) {
-              if (it->second.act_count < it->second.life * m_twice_pruning_interval_threshold) {
-                // Store the entries to be pruned
-                to_be_pruned.emplace_back(it);
+            ActivationTracker<int>& table = m_twice_table[i];
+            // Iterate backwards: erasing an entry moves the (already visited) last entry into its place
+            for (int entry = table.size() - 1; entry >= 0; entry--) {
+              if (table.count(entry) < table.data(entry) * m_twice_pruning_interval_threshold) {
                 if (m_is_debug) {
-                  std::cout << "TWiCeIdeal: Pruned entry " << it->first << " from bank " << i << std::endl;
+                  std::cout << "TWiCeIdeal: Pruned entry " << table.row(entry) << " from bank " << i << std::endl;
                 }
+                table.erase(entry);
               } else {
                 // Increment the life of the entry
-                it->second.life++;
+                table.data(entry)++;
                 if (m_is_debug) {
-                  std::cout << "TWiCeIdeal: Incremented life of entry " << it->first << " in bank " << i << std::endl;
+                  std::cout << "TWiCeIdeal: Incremented life of entry " << table.row(entry) << " in bank " << i << std::endl;
                 }
               }
             }
-            for (auto&& it : to_be_pruned) {
-              m_twice_table[i].erase(it);
-            }
           }
         } else if (m_dram->m_command_meta(req_it->command).is_opening && m_dram->m_command_scopes(req_it->command) == m_row_level) {
           // Activation command
@@ -131,24 +117,25 @@ class TWiCeIdeal : public IControllerPlugin, public Implementation {
             std::cout << "  └  " << "index: " << flat_bank_id << std::endl;
           }
 
-          if (m_twice_table[flat_bank_id].find(row_id) == m_twice_table[flat_bank_id].end()){
-            // If row is not in the table, insert it
-            m_twice_table[flat_bank_id].insert(std::make_pair(row_id, TwiCeEntry(1, 0)));
+          ActivationTracker<int>& table = m_twice_table[flat_bank_id];
+          int entry = table.find(row_id);
+          if (entry == -1){
+            // If row is not in the table, insert it (with an act count of 1 and a life of 0)
+            table.insert(row_id);
             
             if (m_is_debug) {
               std::cout << "TWiCeIdeal: Inserted row " << row_id << " into bank " << flat_bank_id << std::endl;
             }
           } else {
             // If row is in the table, increment the act count
-            m_twice_table[flat_bank_id][row_id].act_count++;
+            table.count(entry)++;
 
-            if (m_twice_table[flat_bank_id][row_id].act_count >= m_twice_rh_threshold) {
+            if (table.count(entry) >= m_twice_rh_threshold) {
               // If the act count is greater than the threshold, issue a VRR
               Request vrr_req(req_it->addr_vec, m_VRR_req_id);
               m_ctrl->priority_send(vrr_req);
 
-              auto it = m_twice_table[flat_bank_id].find(row_id);
-              m_twice_table[flat_bank_id].erase(it);
+              table.erase(entry);
 
               if (m_is_debug) {
                 std::cout << "TWiCeIdeal: VRR on row " << row_id << std::endl;
@@ -0,0 +1,202 @@
+#include <vector>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/power_manager.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Idle-timeout power management.
+ * @details
+ * A rank that has not been sent any command for powerdown_threshold cycles is put into (precharge) power-down,
+ * and one that stays idle for selfrefresh_threshold cycles is moved on to self-refresh. A threshold <= 0 disables
+ * the corresponding state. Sleeping ranks are woken up on demand by the device (PDX/SRX are the prerequisites of
+ * every command sent to them), so the exit latencies (nXP, nXS, nXSDLL) end up in the latency of the requests that
+ * wake them up. The wake-up cost is reported next to the low-power residency; the energy saved shows up in the
+ * background energy of the DRAM power model.
+ */
+class IdleTimeoutPowerManager : public IPowerManager, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IPowerManager, IdleTimeoutPowerManager, "IdleTimeout", "Idle-timeout based power-down and self-refresh.")
+  private:
+    enum class RankState { Awake, PowerDown, SelfRefresh };
+
+    Clk_t m_clk = 0;
+    IDRAM* m_dram = nullptr;
+
+    Clk_t m_powerdown_threshold = -1;
+    Clk_t m_selfrefresh_threshold = -1;
+
+    int m_rank_level = -1;
+    int m_num_ranks = -1;
+    int m_pd_req_id = -1;
+    int m_sr_req_id = -1;
+    int m_pde_cmd = -1;
+    int m_pdx_cmd = -1;
+    int m_sre_cmd = -1;
+    int m_srx_cmd = -1;
+
+    std::vector<RankState> m_rank_states;
+    std::vector<Clk_t> m_last_active_clk;     // Last cycle a command other than a low-power entry/exit was issued to each rank
+    std::vector<Clk_t> m_lowpower_start_clk;  // Cycle each rank entered its current low-power state
+    std::vector<Clk_t> m_wakeup_clk;          // Cycle each rank was woken up on demand (-1 once it served the command)
+    std::vector<bool>  m_entry_pending;       // Whether an entry request of each rank is waiting in the priority buffer
+
+    size_t s_num_powerdowns = 0;
+    size_t s_num_selfrefreshes = 0;
+    size_t s_powerdown_cycles = 0;
+    size_t s_selfrefresh_cycles = 0;
+    size_t s_num_wakeups = 0;
+    size_t s_wakeup_latency = 0;
+    float s_avg_wakeup_latency = 0;
+    float s_powerdown_residency = 0;
+    float s_selfrefresh_residency = 0;
+
+  public:
+    void init() override {
+      m_ctrl = cast_parent<IDRAMController>();
+
+      m_powerdown_threshold = param<Clk_t>("powerdown_threshold").desc("Idle cycles before a rank enters power-down (<= 0 disables power-down).").default_val(100);
+      m_selfrefresh_threshold = param<Clk_t>("selfrefresh_threshold").desc("Idle cycles before a rank enters self-refresh (<= 0 disables self-refresh).").default_val(20000);
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_dram = m_ctrl->m_dram;
+
+      if (!m_dram->m_requests.contains("power-down") || !m_dram->m_requests.contains("self-refresh")) {
+        throw ConfigurationError("[IdleTimeout] The DRAM does not support power-down and self-refresh!");
+      }
+
+      m_rank_level = m_dram->m_levels("rank");
+      m_num_ranks = m_dram->get_level_size("rank");
+
+      m_pd_req_id = m_dram->m_requests("power-down");
+      m_sr_req_id = m_dram->m_requests("self-refresh");
+      m_pde_cmd = m_dram->m_commands("PDE");
+      m_pdx_cmd = m_dram->m_commands("PDX");
+      m_sre_cmd = m_dram->m_commands("SRE");
+      m_srx_cmd = m_dram->m_commands("SRX");
+
+      m_rank_states.resize(m_num_ranks, RankState::Awake);
+      m_last_active_clk.resize(m_num_ranks, 0);
+      m_lowpower_start_clk.resize(m_num_ranks, -1);
+      m_wakeup_clk.resize(m_num_ranks, -1);
+      m_entry_pending.resize(m_num_ranks, false);
+
+      register_stat(s_num_powerdowns).name("num_powerdowns");
+      register_stat(s_num_selfrefreshes).name("num_selfrefreshes");
+      register_stat(s_powerdown_cycles).name("powerdown_cycles");
+      register_stat(s_selfrefresh_cycles).name("selfrefresh_cycles");
+      register_stat(s_powerdown_residency).name("powerdown_residency_pct");
+      register_stat(s_selfrefresh_residency).name("selfrefresh_residency_pct");
+      register_stat(s_num_wakeups).name("num_wakeups");
+      register_stat(s_wakeup_latency).name("wakeup_latency");
+      register_stat(s_avg_wakeup_latency).name("avg_wakeup_latency");
+    };
+
+    void tick() override {
+      m_clk++;
+
+      for (int rank = 0; rank < m_num_ranks; rank++) {
+        // A rank woken up on demand is not idle until it has served the command that woke it up, and a rank with
+        // requests waiting in the controller is not idle at all
+        if (m_entry_pending[rank] || m_wakeup_clk[rank] != -1 || m_ctrl->get_num_outstanding(rank) > 0) {
+          continue;
+        }
+
+        Clk_t idle_cycles = m_clk - m_last_active_clk[rank];
+        if (m_rank_states[rank] == RankState::Awake && m_powerdown_threshold > 0 && idle_cycles >= m_powerdown_threshold) {
+          send_entry(rank, m_pd_req_id);
+        } else if (m_rank_states[rank] != RankState::SelfRefresh && m_selfrefresh_threshold > 0 && idle_cycles >= m_selfrefresh_threshold) {
+          send_entry(rank, m_sr_req_id);
+        }
+      }
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      if (!request_found) {
+        return;
+      }
+
+      int rank = req_it->addr_vec[m_rank_level];
+      if (rank < 0) {
+        return;
+      }
+
+      int command = req_it->command;
+      if (command == m_pde_cmd) {
+        m_rank_states[rank] = RankState::PowerDown;
+        m_lowpower_start_clk[rank] = m_clk;
+        m_entry_pending[rank] = false;
+        s_num_powerdowns++;
+      } else if (command == m_sre_cmd) {
+        m_rank_states[rank] = RankState::SelfRefresh;
+        m_lowpower_start_clk[rank] = m_clk;
+        m_entry_pending[rank] = false;
+        s_num_selfrefreshes++;
+      } else if (command == m_pdx_cmd || command == m_srx_cmd) {
+        end_lowpower(rank);
+        // Only exits for demand requests are wake-ups, not the power-down exit on the way to self-refresh or
+        // the exits forced by refreshes
+        if (!m_entry_pending[rank] && !m_dram->m_command_meta(req_it->final_command).is_refreshing) {
+          s_num_wakeups++;
+          m_wakeup_clk[rank] = m_clk;
+          m_last_active_clk[rank] = m_clk;
+        }
+      } else if (m_rank_states[rank] != RankState::SelfRefresh) {
+        // Refreshes sent to a self-refreshing rank are absorbed by the device and do not wake it up
+        m_last_active_clk[rank] = m_clk;
+        if (m_wakeup_clk[rank] != -1) {
+          s_wakeup_latency += m_clk - m_wakeup_clk[rank];
+          m_wakeup_clk[rank] = -1;
+        }
+      }
+    };
+
+    bool is_stale(const Request& req) override {
+      if (req.type_id != m_pd_req_id && req.type_id != m_sr_req_id) {
+        return false;
+      }
+
+      int rank = req.addr_vec[m_rank_level];
+      if (m_ctrl->get_num_outstanding(rank) == 0) {
+        return false;
+      }
+      m_entry_pending[rank] = false;
+      return true;
+    };
+
+    void finalize() override {
+      for (int rank = 0; rank < m_num_ranks; rank++) {
+        end_lowpower(rank);
+      }
+
+      s_avg_wakeup_latency = s_num_wakeups ? (float) s_wakeup_latency / s_num_wakeups : 0;
+      if (m_clk > 0) {
+        s_powerdown_residency = 100.0f * s_powerdown_cycles / (m_clk * m_num_ranks);
+        s_selfrefresh_residency = 100.0f * s_selfrefresh_cycles / (m_clk * m_num_ranks);
+      }
+    };
+
+  private:
+    void send_entry(int rank, int req_id) {
+      std::vector<int> addr_vec(m_dram->m_levels.size(), -1);
+      addr_vec[0] = m_ctrl->m_channel_id;
+      addr_vec[m_rank_level] = rank;
+      Request req(addr_vec, req_id);
+
+      // Retry in the next cycle if the priority buffer is full
+      m_entry_pending[rank] = m_ctrl->priority_send(req);
+    };
+
+    void end_lowpower(int rank) {
+      if (m_rank_states[rank] == RankState::PowerDown) {
+        s_powerdown_cycles += m_clk - m_lowpower_start_clk[rank];
+      } else if (m_rank_states[rank] == RankState::SelfRefresh) {
+        s_selfrefresh_cycles += m_clk - m_lowpower_start_clk[rank];
+      }
+      m_rank_states[rank] = RankState::Awake;
+    };
+};
+
+}       // namespace Ramulator
@@ -1,4 +1,5 @@
 #include "dram_controller/bh_controller.h"
+#include "dram_controller/impl/utilization_stats.h"
 #include "memory_system/memory_system.h"
 #include "frontend/frontend.h"
 #include "frontend/impl/processor/bhO3/bhllc.h"
@@ -46,6 +47,9 @@ private:
     int s_num_row_misses = 0;
     int s_num_row_conflicts = 0;
 
+    // Bus utilization, idle-cycle causes, and bank-level parallelism
+    UtilizationStats m_utilization;
+
     // DEBUG STAT
     int m_invalidate_ctr = -1;
 
@@ -113,6 +117,8 @@ public:
         register_stat(s_num_row_hits).name("controller_num_row_hits");
         register_stat(s_num_row_misses).name("controller_num_row_misses");
         register_stat(s_num_row_conflicts).name("controller_num_row_conflicts");
+
+        m_utilization.setup(this, m_dram, m_channel_id);
     };
 
     bool send(Request& req) override {
@@ -146,6 +152,7 @@ public:
             req.arrive = -1;
             return false;
         }
+        m_utilization.add_outstanding(req.addr_vec, 1);
 
         return true;
     };
@@ -196,6 +203,15 @@ public:
             plugin->update(request_found, req_it);
         }
 
+        // Account bus utilization and bank-level parallelism
+        if (m_utilization.update(request_found, req_it)) {
+            const ReqBuffer& serving_buffer = m_active_buffer.size() != 0 ? m_active_buffer : (m_is_write_mode ? m_write_buffer : m_read_buffer);
+            bool has_requests = m_active_buffer.size() != 0 || m_read_buffer.size() != 0 || m_write_buffer.size() != 0;
+            // Requests are held back during (and right before) an ABO recovery
+            bool is_mitigating = m_prac_buffer.size() != 0 || m_scheduler->is_blocking_for_mitigation();
+            m_utilization.attribute_idle_cycle(m_priority_buffer, has_requests, is_mitigating, serving_buffer);
+        }
+
         // Issue the commands to serve the request
         if (request_found) {
             m_dram->issue_command(req_it->command, req_it->addr_vec);
@@ -209,9 +225,15 @@ public:
                 else if (req_it->type_id == Request::Type::Write) {
                     // TODO: Add code to update statistics
                 }
+                if (buffer != &m_priority_buffer && buffer != &m_prac_buffer) {
+                    m_utilization.add_outstanding(req_it->addr_vec, -1);
+                }
                 buffer->remove(req_it);
             }
             else if (m_dram->m_command_meta(req_it->command).is_opening) {
+                if (buffer == &m_priority_buffer) {
+                    m_utilization.add_outstanding(req_it->addr_vec, 1);
+                }
                 m_active_buffer.enqueue(*req_it);
                 buffer->remove(req_it);
             }
@@ -257,10 +279,12 @@ private:
         if (!m_is_write_mode) {
             if ((m_write_buffer.size() > m_wr_high_watermark * m_write_buffer.max_size) || m_read_buffer.size() == 0) {
                 m_is_write_mode = true;
+                m_utilization.count_rw_switch();
             }
         } else {
             if ((m_write_buffer.size() < m_wr_low_watermark * m_write_buffer.max_size) && m_read_buffer.size() != 0) {
                 m_is_write_mode = false;
+                m_utilization.count_rw_switch();
             }
         }
     };
@@ -365,6 +389,7 @@ private:
     }
 
     void finalize() override {
+        m_utilization.finalize();
     }
 };
 }   // namespace Ramulator
\ No newline at end of file
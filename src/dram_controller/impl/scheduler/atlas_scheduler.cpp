@@ -0,0 +1,134 @@
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/scheduler.h"
+#include "dram_controller/impl/scheduler/thread_aware_scheduler.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Adaptive per-Thread Least-Attained-Service scheduling (Kim et al., HPCA'10).
+ * @details
+ * Every issued command adds its estimated bank-busy cycles to the attained service of its core.
+ * At the end of each quantum the service is folded into an exponentially weighted history and the
+ * cores are re-ranked (least attained service first). Priority: requests older than the starvation
+ * threshold > higher rank > ready > oldest. Ranks are only recomputed once per quantum.
+ */
+class ATLAS : public IScheduler, public Implementation, public ThreadAwareScheduler {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IScheduler, ATLAS, "ATLAS", "Adaptive per-Thread Least-Attained-Service Scheduler.")
+  private:
+    Clk_t m_quantum = -1;
+    double m_alpha = -1;
+    Clk_t m_starvation_threshold = -1;
+
+    std::vector<double> m_quantum_service;    // Attained service of each core in the current quantum
+    std::vector<double> m_total_service;      // Exponentially weighted attained service of each core
+
+    static constexpr int STARVED_IDX = 3;
+
+    size_t s_num_quanta = 0;
+    size_t s_num_starved_reqs = 0;
+
+  public:
+    void init() override {
+      m_quantum = param<Clk_t>("quantum").desc("Length of a ranking quantum in controller cycles.").default_val(1000000);
+      m_alpha = param<double>("alpha").desc("Weight of the attained-service history.").default_val(0.875);
+      m_starvation_threshold = param<Clk_t>("starvation_threshold").desc("Age (in cycles) after which a request is prioritized over ranks.").default_val(100000);
+      if (m_quantum <= 0) {
+        throw ConfigurationError("[ATLAS] quantum must be positive!");
+      }
+      if (m_alpha < 0 || m_alpha >= 1) {
+        throw ConfigurationError("[ATLAS] alpha must be in [0, 1)!");
+      }
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      setup_thread_aware(this, frontend);
+      m_quantum_service.resize(m_num_cores, 0);
+      m_total_service.resize(m_num_cores, 0);
+
+      register_stat(s_num_quanta).name("num_quanta");
+      register_stat(s_num_starved_reqs).name("num_starved_requests");
+    };
+
+    ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+      bool starved1 = req1->scratchpad[STARVED_IDX];
+      bool starved2 = req2->scratchpad[STARVED_IDX];
+
+      if (starved1 ^ starved2) {
+        if (starved1) {
+          return req1;
+        } else {
+          return req2;
+        }
+      }
+
+      return compare_rank(req1, req2);
+    }
+
+    ReqBuffer::iterator get_best_request(ReqBuffer& buffer) override {
+      if (buffer.size() == 0) {
+        return buffer.end();
+      }
+
+      // Starved > higher rank > ready > oldest
+      return find_best_request(this, buffer, [this](Request& req) {
+        req.scratchpad[RANK_IDX] = get_rank(req);
+        req.scratchpad[STARVED_IDX] = m_clk - req.arrive > m_starvation_threshold;
+        return std::make_pair((int) !req.scratchpad[STARVED_IDX] * (m_num_cores + 1) + (int) req.scratchpad[RANK_IDX], 0);
+      });
+    }
+
+    void on_enqueue(const Request& req) override {
+      track_enqueue(req);
+    }
+
+    void on_retire(const Request& req) override {
+      track_retire(req);
+    }
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      account_cycle(request_found, req_it);
+
+      if (request_found) {
+        if (int core_id = get_core_id(*req_it); core_id >= 0) {
+          m_quantum_service[core_id] += m_cmd_service[req_it->command];
+        }
+        if (req_it->command == req_it->final_command && req_it->scratchpad[STARVED_IDX]) {
+          s_num_starved_reqs++;
+        }
+      }
+
+      next_cycle();
+      if (m_clk % m_quantum == 0) {
+        rerank();
+      }
+    }
+
+    void finalize() override {
+      finalize_slowdowns();
+    }
+
+  private:
+    void rerank() {
+      s_num_quanta++;
+      for (int core_id = 0; core_id < m_num_cores; core_id++) {
+        m_total_service[core_id] = m_alpha * m_total_service[core_id] + (1 - m_alpha) * m_quantum_service[core_id];
+        m_quantum_service[core_id] = 0;
+      }
+
+      std::vector<int> order(m_num_cores);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return m_total_service[a] < m_total_service[b];
+      });
+      for (int rank = 0; rank < m_num_cores; rank++) {
+        m_ranks[order[rank]] = rank;
+      }
+    }
+};
+
+}       // namespace Ramulator
@@ -16,6 +16,8 @@ class BlockingScheduler : public IBHScheduler, public Implementation {
 
     int m_clk = -1;
 
+    bool m_is_blocking = false;   // Whether the last call to get_best_request found only unsafe requests
+
     // stats
     int s_num_blacklist = 0;
 
@@ -55,6 +57,7 @@ class BlockingScheduler : public IBHScheduler, public Implementation {
     }
 
     ReqBuffer::iterator get_best_request(ReqBuffer& buffer) override {
+      m_is_blocking = false;
       if (buffer.size() == 0) {
         return buffer.end();
       }
@@ -69,6 +72,7 @@ class BlockingScheduler : public IBHScheduler, public Implementation {
       }
 
       if (candidate == buffer.end()) {
+        m_is_blocking = true;
         return buffer.end();
       }
 
@@ -82,6 +86,10 @@ class BlockingScheduler : public IBHScheduler, public Implementation {
       return candidate;
     }
 
+    bool is_blocking_for_mitigation() override {
+      return m_is_blocking;
+    }
+
     virtual void tick() override {
       m_clk++;
     }
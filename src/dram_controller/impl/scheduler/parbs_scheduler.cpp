@@ -0,0 +1,174 @@
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/scheduler.h"
+#include "dram_controller/impl/scheduler/thread_aware_scheduler.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Parallelism-Aware Batch Scheduling (Mutlu & Moscibroda, ISCA'08).
+ * @details
+ * When no marked request is left, the scheduler marks up to batch_cap of the oldest requests of every
+ * (core, bank) pair as a new batch and ranks the cores once (fewest requests to their most loaded bank
+ * first, then fewest marked requests in total). Priority: marked > ready > higher rank > oldest.
+ * Ranks only change at batch boundaries, so the per-request cost of get_best_request is O(1), and the device
+ * state is only queried for requests that can still win.
+ */
+class PARBS : public IScheduler, public Implementation, public ThreadAwareScheduler {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IScheduler, PARBS, "PARBS", "Parallelism-Aware Batch Scheduler.")
+  private:
+    int m_batch_cap = -1;
+
+    int m_num_marked = 0;                   // Number of marked requests still not served
+    Clk_t m_batch_clk = -1;                 // Cycle in which the current batch was formed
+    std::vector<int> m_marked_per_bank;     // (core, bank) -> number of requests marked in the current batch
+
+    size_t s_num_batches = 0;
+    size_t s_num_marked_reqs = 0;
+
+  public:
+    void init() override {
+      m_batch_cap = param<int>("batch_cap").desc("Maximum number of requests marked per core per bank in a batch.").default_val(5);
+      if (m_batch_cap <= 0) {
+        throw ConfigurationError("[PARBS] batch_cap must be positive!");
+      }
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      setup_thread_aware(this, frontend);
+      m_marked_per_bank.resize(m_num_cores * m_num_banks, 0);
+
+      register_stat(s_num_batches).name("num_batches");
+      register_stat(s_num_marked_reqs).name("num_marked_requests");
+    };
+
+    ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+      bool marked1 = req1->scratchpad[MARK_IDX];
+      bool marked2 = req2->scratchpad[MARK_IDX];
+
+      if (marked1 ^ marked2) {
+        if (marked1) {
+          return req1;
+        } else {
+          return req2;
+        }
+      }
+
+      bool ready1 = req1->scratchpad[READY_IDX];
+      bool ready2 = req2->scratchpad[READY_IDX];
+
+      if (ready1 ^ ready2) {
+        if (ready1) {
+          return req1;
+        } else {
+          return req2;
+        }
+      }
+
+      return compare_rank(req1, req2);
+    }
+
+    ReqBuffer::iterator get_best_request(ReqBuffer& buffer) override {
+      if (buffer.size() == 0) {
+        return buffer.end();
+      }
+
+      // A batch formed in this cycle stays open so that every buffer scheduled in the same cycle joins it
+      if (m_num_marked == 0 || m_batch_clk == m_clk) {
+        form_batch(buffer);
+      }
+
+      // Marked > ready > higher rank > oldest
+      return find_best_request(this, buffer, [this](Request& req) {
+        req.scratchpad[RANK_IDX] = get_rank(req);
+        return std::make_pair((int) !req.scratchpad[MARK_IDX], (int) req.scratchpad[RANK_IDX]);
+      });
+    }
+
+    void on_enqueue(const Request& req) override {
+      track_enqueue(req);
+    }
+
+    void on_retire(const Request& req) override {
+      track_retire(req);
+    }
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      account_cycle(request_found, req_it);
+
+      if (request_found && req_it->command == req_it->final_command && req_it->scratchpad[MARK_IDX]) {
+        req_it->scratchpad[MARK_IDX] = 0;
+        m_num_marked--;
+      }
+
+      next_cycle();
+    }
+
+    void finalize() override {
+      finalize_slowdowns();
+    }
+
+  private:
+    /**
+     * @brief    Marks the oldest requests of each (core, bank) and re-ranks the cores of the new batch.
+     */
+    void form_batch(ReqBuffer& buffer) {
+      if (m_batch_clk != m_clk) {
+        m_batch_clk = m_clk;
+        std::fill(m_marked_per_bank.begin(), m_marked_per_bank.end(), 0);
+      }
+      int num_newly_marked = 0;
+
+      // The buffers keep requests in arrival order, so the first ones we see are the oldest
+      for (auto& req : buffer) {
+        int core_id = get_core_id(req);
+        if (core_id < 0) {
+          continue;
+        }
+        int& marked = m_marked_per_bank[core_id * m_num_banks + get_flat_bank_id(req)];
+        if (!req.scratchpad[MARK_IDX] && marked < m_batch_cap) {
+          marked++;
+          req.scratchpad[MARK_IDX] = 1;
+          num_newly_marked++;
+        }
+      }
+
+      if (num_newly_marked == 0) {
+        return;
+      }
+      if (m_num_marked == 0) {
+        s_num_batches++;
+      }
+      m_num_marked += num_newly_marked;
+      s_num_marked_reqs += num_newly_marked;
+
+      // Max-total ranking: the core with the lightest most-loaded bank goes first
+      std::vector<int> max_bank_load(m_num_cores, 0);
+      std::vector<int> total_load(m_num_cores, 0);
+      for (int core_id = 0; core_id < m_num_cores; core_id++) {
+        for (int bank_id = 0; bank_id < m_num_banks; bank_id++) {
+          int load = m_marked_per_bank[core_id * m_num_banks + bank_id];
+          max_bank_load[core_id] = std::max(max_bank_load[core_id], load);
+          total_load[core_id] += load;
+        }
+      }
+
+      std::vector<int> order(m_num_cores);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        if (max_bank_load[a] != max_bank_load[b]) {
+          return max_bank_load[a] < max_bank_load[b];
+        }
+        return total_load[a] < total_load[b];
+      });
+      for (int rank = 0; rank < m_num_cores; rank++) {
+        m_ranks[order[rank]] = rank;
+      }
+    }
+};
+
+}       // namespace Ramulator
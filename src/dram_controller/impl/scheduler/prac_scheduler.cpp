@@ -21,6 +21,8 @@ private:
 
     bool m_is_debug = false; 
 
+    bool m_is_blocking = false;   // Whether the last call to get_best_request found no request that fits before the next recovery
+
     const int FITS_IDX = 0;
     const int READY_IDX = 1;
 
@@ -74,6 +76,7 @@ public:
     }
 
     ReqBuffer::iterator get_best_request(ReqBuffer& buffer) override {
+        m_is_blocking = false;
         if (buffer.size() == 0) {
             return buffer.end();
         }
@@ -89,9 +92,15 @@ public:
         for (auto next = std::next(buffer.begin(), 1); next != buffer.end(); next++) {
             candidate = compare(candidate, next);
         }
+        // Requests that fit are preferred, so the controller holds back the whole buffer if the best one does not fit
+        m_is_blocking = !candidate->scratchpad[FITS_IDX];
         return candidate;
     }
 
+    bool is_blocking_for_mitigation() override {
+        return m_is_blocking;
+    }
+
     virtual void tick() override {
         m_clk++;
     }
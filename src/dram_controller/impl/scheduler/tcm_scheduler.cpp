@@ -0,0 +1,205 @@
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/scheduler.h"
+#include "dram_controller/impl/scheduler/thread_aware_scheduler.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Thread Cluster Memory scheduling (Kim et al., MICRO'10).
+ * @details
+ * At the end of each quantum the cores are split into two clusters. The least memory-intensive cores
+ * (intensity = requests served in the quantum) form the latency-sensitive cluster until their share of
+ * the attained service reaches cluster_threshold; they are always ranked above the rest, least intensive
+ * first. The bandwidth-sensitive cores are ordered by niceness (high bank-level parallelism and low
+ * row-buffer locality is nice) and their ranks are rotated every shuffle_interval cycles.
+ * Priority: higher rank > ready > oldest.
+ */
+class TCM : public IScheduler, public Implementation, public ThreadAwareScheduler {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IScheduler, TCM, "TCM", "Thread Cluster Memory Scheduler.")
+  private:
+    Clk_t m_quantum = -1;
+    Clk_t m_shuffle_interval = -1;
+    double m_cluster_threshold = -1;
+
+    // Per-core monitors of the current quantum
+    std::vector<size_t> m_num_served;       // Number of requests served (memory intensity)
+    std::vector<size_t> m_num_activations;  // Number of row-opening commands (to estimate row-buffer locality)
+    std::vector<double> m_service;          // Attained service
+    std::vector<size_t> m_blp_sum;          // Sum of banks with waiting requests over all cycles...
+    std::vector<size_t> m_blp_cycles;       // ... and the number of cycles with any waiting request
+
+    std::vector<int> m_bandwidth_cluster;   // Cores in the bandwidth-sensitive cluster, nicest first
+    int m_latency_cluster_size = 0;
+    size_t m_shuffle_offset = 0;
+
+    size_t s_num_quanta = 0;
+    size_t s_latency_cluster_size_sum = 0;
+
+  public:
+    void init() override {
+      m_quantum = param<Clk_t>("quantum").desc("Length of a clustering quantum in controller cycles.").default_val(1000000);
+      m_shuffle_interval = param<Clk_t>("shuffle_interval").desc("Interval (in cycles) between rank shuffles of the bandwidth-sensitive cluster.").default_val(800);
+      m_cluster_threshold = param<double>("cluster_threshold").desc("Fraction of the total attained service allowed for the latency-sensitive cluster.").default_val(0.1);
+      if (m_quantum <= 0 || m_shuffle_interval <= 0) {
+        throw ConfigurationError("[TCM] quantum and shuffle_interval must be positive!");
+      }
+      if (m_cluster_threshold < 0 || m_cluster_threshold > 1) {
+        throw ConfigurationError("[TCM] cluster_threshold must be in [0, 1]!");
+      }
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      setup_thread_aware(this, frontend);
+      m_num_served.resize(m_num_cores, 0);
+      m_num_activations.resize(m_num_cores, 0);
+      m_service.resize(m_num_cores, 0);
+      m_blp_sum.resize(m_num_cores, 0);
+      m_blp_cycles.resize(m_num_cores, 0);
+
+      // Until the first quantum ends, every core is treated as bandwidth-sensitive
+      m_bandwidth_cluster.resize(m_num_cores);
+      std::iota(m_bandwidth_cluster.begin(), m_bandwidth_cluster.end(), 0);
+
+      register_stat(s_num_quanta).name("num_quanta");
+      register_stat(s_latency_cluster_size_sum).name("latency_cluster_size_sum");
+    };
+
+    ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
+      return compare_rank(req1, req2);
+    }
+
+    ReqBuffer::iterator get_best_request(ReqBuffer& buffer) override {
+      if (buffer.size() == 0) {
+        return buffer.end();
+      }
+
+      // Higher rank > ready > oldest
+      return find_best_request(this, buffer, [this](Request& req) {
+        req.scratchpad[RANK_IDX] = get_rank(req);
+        return std::make_pair((int) req.scratchpad[RANK_IDX], 0);
+      });
+    }
+
+    void on_enqueue(const Request& req) override {
+      track_enqueue(req);
+    }
+
+    void on_retire(const Request& req) override {
+      track_retire(req);
+    }
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      account_cycle(request_found, req_it);
+
+      for (int core_id = 0; core_id < m_num_cores; core_id++) {
+        if (m_waiting_banks[core_id] > 0) {
+          m_blp_sum[core_id] += m_waiting_banks[core_id];
+          m_blp_cycles[core_id]++;
+        }
+      }
+
+      if (request_found) {
+        if (int core_id = get_core_id(*req_it); core_id >= 0) {
+          m_service[core_id] += m_cmd_service[req_it->command];
+          if (m_dram->m_command_meta(req_it->command).is_opening) {
+            m_num_activations[core_id]++;
+          }
+          if (req_it->command == req_it->final_command) {
+            m_num_served[core_id]++;
+          }
+        }
+      }
+
+      next_cycle();
+      if (m_clk % m_quantum == 0) {
+        cluster();
+      } else if (m_clk % m_shuffle_interval == 0) {
+        shuffle();
+      }
+    }
+
+    void finalize() override {
+      finalize_slowdowns();
+    }
+
+  private:
+    /**
+     * @brief    Re-clusters the cores with the monitors of the quantum that just ended.
+     */
+    void cluster() {
+      s_num_quanta++;
+
+      std::vector<int> order(m_num_cores);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return m_num_served[a] < m_num_served[b];
+      });
+
+      double total_service = std::accumulate(m_service.begin(), m_service.end(), 0.0);
+      double latency_service = 0;
+      m_latency_cluster_size = 0;
+      for (int core_id : order) {
+        latency_service += m_service[core_id];
+        if (latency_service > m_cluster_threshold * total_service) {
+          break;
+        }
+        m_ranks[core_id] = m_latency_cluster_size++;
+      }
+      s_latency_cluster_size_sum += m_latency_cluster_size;
+
+      // Niceness = rank by bank-level parallelism - rank by row-buffer locality
+      m_bandwidth_cluster.assign(order.begin() + m_latency_cluster_size, order.end());
+      int num_bw_cores = m_bandwidth_cluster.size();
+      std::vector<double> blp(m_num_cores, 0), rbl(m_num_cores, 0);
+      for (int core_id : m_bandwidth_cluster) {
+        blp[core_id] = m_blp_cycles[core_id] ? (double) m_blp_sum[core_id] / m_blp_cycles[core_id] : 0;
+        rbl[core_id] = m_num_served[core_id] ? 1.0 - std::min(1.0, (double) m_num_activations[core_id] / m_num_served[core_id]) : 0;
+      }
+      std::vector<int> niceness(m_num_cores, 0);
+      auto add_rank = [&](const std::vector<double>& metric, int sign) {
+        std::vector<int> by_metric = m_bandwidth_cluster;
+        std::stable_sort(by_metric.begin(), by_metric.end(), [&](int a, int b) { return metric[a] < metric[b]; });
+        for (int i = 0; i < num_bw_cores; i++) {
+          niceness[by_metric[i]] += sign * i;
+        }
+      };
+      add_rank(blp, 1);
+      add_rank(rbl, -1);
+      std::stable_sort(m_bandwidth_cluster.begin(), m_bandwidth_cluster.end(), [&](int a, int b) {
+        return niceness[a] > niceness[b];
+      });
+      m_shuffle_offset = 0;
+      assign_bandwidth_ranks();
+
+      std::fill(m_num_served.begin(), m_num_served.end(), 0);
+      std::fill(m_num_activations.begin(), m_num_activations.end(), 0);
+      std::fill(m_service.begin(), m_service.end(), 0);
+      std::fill(m_blp_sum.begin(), m_blp_sum.end(), 0);
+      std::fill(m_blp_cycles.begin(), m_blp_cycles.end(), 0);
+    }
+
+    /**
+     * @brief    Rotates the ranks of the bandwidth-sensitive cluster so that no core is always last.
+     */
+    void shuffle() {
+      if (m_bandwidth_cluster.size() > 1) {
+        m_shuffle_offset = (m_shuffle_offset + 1) % m_bandwidth_cluster.size();
+        assign_bandwidth_ranks();
+      }
+    }
+
+    void assign_bandwidth_ranks() {
+      int num_bw_cores = m_bandwidth_cluster.size();
+      for (int i = 0; i < num_bw_cores; i++) {
+        int core_id = m_bandwidth_cluster[(i + m_shuffle_offset) % num_bw_cores];
+        m_ranks[core_id] = m_latency_cluster_size + i;
+      }
+    }
+};
+
+}       // namespace Ramulator
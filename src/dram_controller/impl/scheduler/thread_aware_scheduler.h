@@ -0,0 +1,275 @@
+#ifndef RAMULATOR_CONTROLLER_THREAD_AWARE_SCHEDULER_H
+#define RAMULATOR_CONTROLLER_THREAD_AWARE_SCHEDULER_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/scheduler.h"
+#include "frontend/frontend.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Common bookkeeping for thread-aware (QoS) schedulers.
+ * @details
+ * Keeps a per-core rank (lower is better) that the concrete scheduler maintains incrementally,
+ * and estimates each core's slowdown STFM-style: a core stalls whenever it has requests waiting
+ * in the controller, and the cycles in which another core's command was issued instead are
+ * counted as interference. The alone stall time is then estimated as (stall - interference).
+ *
+ * Requests whose source_id is unknown (e.g., refreshes, writebacks without a core) are put
+ * behind every ranked core and fall back to FR-FCFS ordering.
+ *
+ * The waiting requests of each (core, bank) are counted as they enter and leave the controller, so
+ * nothing has to be rescanned per cycle to know which cores are stalled.
+ */
+class ThreadAwareScheduler {
+  protected:
+    IDRAM* m_dram = nullptr;
+
+    Clk_t m_clk = 0;
+
+    int m_num_cores = 0;
+    int m_num_banks = 0;                 // Number of banks in one channel
+    int m_bank_level = -1;
+    std::vector<int> m_bank_strides;     // Strides to flatten the addr_vec (below channel) into a bank id
+
+    std::vector<int> m_ranks;            // Rank of each core, 0 = highest priority
+    std::vector<int> m_cmd_service;      // Estimated bank-busy cycles of each command
+
+    // Which cores have requests waiting, and on which banks
+    std::vector<int> m_bank_num_waiting; // (core, bank) -> number of requests waiting in the controller
+    std::vector<int> m_waiting_banks;    // core -> number of distinct banks with waiting requests
+
+    // Scratchpad slots used by the thread-aware schedulers
+    static constexpr int READY_IDX = 0;
+    static constexpr int RANK_IDX  = 1;
+    static constexpr int MARK_IDX  = 2;
+
+    // Stats
+    std::vector<Clk_t> s_stall_cycles_per_core;
+    std::vector<Clk_t> s_interference_cycles_per_core;
+    std::vector<float> s_slowdown_per_core;
+    float s_weighted_speedup = 0;
+    float s_max_slowdown = 0;
+
+  protected:
+    void setup_thread_aware(Implementation* impl, IFrontEnd* frontend) {
+      m_dram = impl->cast_parent<IDRAMController>()->m_dram;
+      m_num_cores = frontend->get_num_cores();
+
+      m_bank_level = m_dram->m_levels("bank");
+      m_bank_strides.resize(m_bank_level + 1, 0);
+      m_num_banks = 1;
+      for (int level = m_bank_level; level > 0; level--) {
+        m_bank_strides[level] = m_num_banks;
+        m_num_banks *= m_dram->m_organization.count[level];
+      }
+
+      m_ranks.resize(m_num_cores);
+      for (int core_id = 0; core_id < m_num_cores; core_id++) {
+        m_ranks[core_id] = core_id;
+      }
+
+      auto timing_or_one = [this] (std::initializer_list<std::string_view> names) {
+        for (auto name : names) {
+          if (m_dram->m_timings.contains(name)) {
+            return std::max(m_dram->m_timing_vals(name), 1);
+          }
+        }
+        return 1;
+      };
+      int access_cost = timing_or_one({"nBL", "nBL16"});
+      int open_cost   = timing_or_one({"nRCD", "nRCDRD"});
+      int close_cost  = timing_or_one({"nRP", "nRPpb"});
+      m_cmd_service.resize(m_dram->m_commands.size(), 0);
+      for (int cmd = 0; cmd < m_dram->m_commands.size(); cmd++) {
+        const auto& meta = m_dram->m_command_meta(cmd);
+        if (meta.is_accessing) {
+          m_cmd_service[cmd] += access_cost;
+        }
+        if (meta.is_opening) {
+          m_cmd_service[cmd] += open_cost;
+        }
+        if (meta.is_closing && !meta.is_refreshing) {
+          m_cmd_service[cmd] += close_cost;
+        }
+      }
+
+      m_bank_num_waiting.resize(m_num_cores * m_num_banks, 0);
+      m_waiting_banks.resize(m_num_cores, 0);
+
+      s_stall_cycles_per_core.resize(m_num_cores, 0);
+      s_interference_cycles_per_core.resize(m_num_cores, 0);
+      s_slowdown_per_core.resize(m_num_cores, 1.0f);
+      for (int core_id = 0; core_id < m_num_cores; core_id++) {
+        impl->register_stat(s_stall_cycles_per_core[core_id]).name("stall_cycles_core_{}", core_id);
+        impl->register_stat(s_interference_cycles_per_core[core_id]).name("interference_cycles_core_{}", core_id);
+        impl->register_stat(s_slowdown_per_core[core_id]).name("slowdown_core_{}", core_id);
+      }
+      impl->register_stat(s_weighted_speedup).name("weighted_speedup");
+      impl->register_stat(s_max_slowdown).name("max_slowdown");
+    }
+
+    /**
+     * @brief    Returns the core id of the request, or -1 if it does not belong to a known core.
+     */
+    int get_core_id(const Request& req) const {
+      return (req.source_id >= 0 && req.source_id < m_num_cores) ? req.source_id : -1;
+    }
+
+    /**
+     * @brief    Returns the rank of the request's core. Unknown sources rank behind all cores.
+     */
+    int get_rank(const Request& req) const {
+      int core_id = get_core_id(req);
+      return core_id < 0 ? m_num_cores : m_ranks[core_id];
+    }
+
+    int get_flat_bank_id(const Request& req) const {
+      int flat_bank_id = 0;
+      for (int level = 1; level <= m_bank_level; level++) {
+        flat_bank_id += std::max(req.addr_vec[level], 0) * m_bank_strides[level];
+      }
+      return flat_bank_id;
+    }
+
+    /**
+     * @brief    Records that a request of the core is waiting on its bank.
+     */
+    void track_enqueue(const Request& req) {
+      if (int core_id = get_core_id(req); core_id >= 0) {
+        if (m_bank_num_waiting[core_id * m_num_banks + get_flat_bank_id(req)]++ == 0) {
+          m_waiting_banks[core_id]++;
+        }
+      }
+    }
+
+    /**
+     * @brief    Records that a request of the core is no longer waiting on its bank.
+     */
+    void track_retire(const Request& req) {
+      if (int core_id = get_core_id(req); core_id >= 0) {
+        if (--m_bank_num_waiting[core_id * m_num_banks + get_flat_bank_id(req)] == 0) {
+          m_waiting_banks[core_id]--;
+        }
+      }
+    }
+
+    /**
+     * @brief    Returns the request compare() prefers over all others in the buffer.
+     * @details
+     * The concrete schedulers order requests by (major key, ready, minor key, age). get_keys fills in the
+     * scratchpad fields compare() needs and returns the major and minor keys (lower is better). The keys
+     * are cheap, so the command and readiness, which query the device state, are only computed for
+     * requests that could still beat the best request found so far. The result is the same as folding
+     * compare() over the whole buffer.
+     */
+    template <typename GetKeys>
+    ReqBuffer::iterator find_best_request(IScheduler* scheduler, ReqBuffer& buffer, GetKeys get_keys) {
+      auto best = buffer.end();
+      int best_major = 0;
+      int best_minor = 0;
+      for (auto it = buffer.begin(); it != buffer.end(); it++) {
+        auto [major, minor] = get_keys(*it);
+        if (best != buffer.end()) {
+          if (major > best_major) {
+            continue;
+          }
+          if (major == best_major && best->scratchpad[READY_IDX] &&
+              (minor > best_minor || (minor == best_minor && it->arrive >= best->arrive))) {
+            continue;
+          }
+        }
+
+        it->command = m_dram->get_preq_command(it->final_command, it->addr_vec);
+        it->scratchpad[READY_IDX] = m_dram->check_ready(it->command, it->addr_vec);
+        if (best == buffer.end() || scheduler->compare(best, it) == it) {
+          best = it;
+          best_major = major;
+          best_minor = minor;
+        }
+      }
+      return best;
+    }
+
+    /**
+     * @brief    Accounts stall and interference cycles for the cycle that just finished.
+     */
+    void account_cycle(bool request_found, ReqBuffer::iterator& req_it) {
+      int served_core = request_found ? get_core_id(*req_it) : -1;
+      for (int core_id = 0; core_id < m_num_cores; core_id++) {
+        if (m_waiting_banks[core_id] == 0) {
+          continue;
+        }
+        s_stall_cycles_per_core[core_id]++;
+        if (request_found && served_core != core_id) {
+          s_interference_cycles_per_core[core_id]++;
+        }
+      }
+    }
+
+    void next_cycle() {
+      m_clk++;
+    }
+
+    void finalize_slowdowns() {
+      s_weighted_speedup = 0;
+      s_max_slowdown = 0;
+      for (int core_id = 0; core_id < m_num_cores; core_id++) {
+        Clk_t stall = s_stall_cycles_per_core[core_id];
+        Clk_t alone_stall = std::max<Clk_t>(stall - s_interference_cycles_per_core[core_id], 1);
+        s_slowdown_per_core[core_id] = stall > 0 ? (float) stall / (float) alone_stall : 1.0f;
+        s_weighted_speedup += 1.0f / s_slowdown_per_core[core_id];
+        s_max_slowdown = std::max(s_max_slowdown, s_slowdown_per_core[core_id]);
+      }
+    }
+
+    /**
+     * @brief    FR-FCFS tie breaker shared by all thread-aware schedulers (ready first, then oldest first).
+     */
+    static ReqBuffer::iterator compare_frfcfs(ReqBuffer::iterator req1, ReqBuffer::iterator req2) {
+      bool ready1 = req1->scratchpad[READY_IDX];
+      bool ready2 = req2->scratchpad[READY_IDX];
+
+      if (ready1 ^ ready2) {
+        if (ready1) {
+          return req1;
+        } else {
+          return req2;
+        }
+      }
+
+      if (req1->arrive <= req2->arrive) {
+        return req1;
+      } else {
+        return req2;
+      }
+    }
+
+    /**
+     * @brief    Higher-ranked core first, then FR-FCFS.
+     */
+    static ReqBuffer::iterator compare_rank(ReqBuffer::iterator req1, ReqBuffer::iterator req2) {
+      int rank1 = req1->scratchpad[RANK_IDX];
+      int rank2 = req2->scratchpad[RANK_IDX];
+
+      if (rank1 != rank2) {
+        if (rank1 < rank2) {
+          return req1;
+        } else {
+          return req2;
+        }
+      }
+
+      return compare_frfcfs(req1, req2);
+    }
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_CONTROLLER_THREAD_AWARE_SCHEDULER_H
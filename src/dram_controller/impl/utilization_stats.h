@@ -0,0 +1,277 @@
+#ifndef RAMULATOR_CONTROLLER_UTILIZATION_STATS_H
+#define RAMULATOR_CONTROLLER_UTILIZATION_STATS_H
+
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+#include "base/base.h"
+#include "dram/dram.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Data/command bus utilization, idle-cycle causes, and bank-level parallelism of one channel.
+ * @details
+ * Shared by the DRAM controllers. The controller reports requests entering and leaving its buffers
+ * (add_outstanding), calls update() once per cycle before issuing the command, and attribute_idle_cycle()
+ * in the cycles in which the data bus is idle.
+ *
+ * The turnaround and four-activation-window latencies are read off the device's timing constraints
+ * (instead of looking up timing names) so that they hold for every DRAM standard.
+ */
+class UtilizationStats {
+  private:
+    IDRAM* m_dram = nullptr;
+    Clk_t m_clk = 0;                              // Number of cycles accounted so far
+
+    int m_bank_level = -1;
+    int m_num_banks = 0;                          // Number of banks in this channel
+    std::vector<int> m_bank_strides;              // Strides to flatten the addr_vec (below channel) into a bank id
+    std::vector<int> m_bank_num_outstanding;      // Number of requests of each bank in the active, read, and write buffers
+    int m_num_active_banks = 0;                   // Number of banks with outstanding requests
+
+    int m_read_cmd = -1;
+    int m_write_cmd = -1;
+    int m_burst_cycles = 1;                       // Data-bus cycles occupied by one access (nBL)
+    int m_wtr_latency = 0;                        // Write-to-read turnaround (e.g., nCWL + nBL + nWTR)
+    int m_rtw_latency = 0;                        // Read-to-write turnaround
+    int m_faw_level = -1;                         // Level of the four-activation-window constraint (usually the rank)
+    int m_faw_window = 0;                         // Number of activations in a four-activation-window ...
+    int m_faw_latency = 0;                        // ... and its length
+    Clk_t m_last_read_clk = -1;
+    Clk_t m_last_write_clk = -1;
+    Clk_t m_data_bus_busy_until = -1;
+    std::vector<std::deque<Clk_t>> m_act_history; // Issue history of the activations of each node at m_faw_level
+
+    size_t s_data_bus_busy_cycles = 0;
+    size_t s_cmd_bus_busy_cycles = 0;
+    size_t s_idle_cycles_refresh = 0;
+    size_t s_idle_cycles_rw_turnaround = 0;
+    size_t s_idle_cycles_faw = 0;
+    size_t s_idle_cycles_no_request = 0;
+    size_t s_idle_cycles_rh_mitigation = 0;
+    size_t s_idle_cycles_other = 0;
+    size_t s_num_rw_switches = 0;
+    size_t s_active_banks = 0;
+    size_t s_active_bank_cycles = 0;
+    float s_avg_bank_parallelism = 0;
+    float s_bandwidth = 0;
+    float s_peak_bandwidth = 0;
+    float s_data_bus_utilization = 0;
+    float s_cmd_bus_utilization = 0;
+
+  public:
+    /**
+     * @brief    Derives the parameters of the device and registers the stats with the controller.
+     */
+    void setup(Implementation* impl, IDRAM* dram, int channel_id) {
+      m_dram = dram;
+
+      m_bank_level = m_dram->m_levels("bank");
+      m_bank_strides.resize(m_bank_level + 1, 0);
+      m_num_banks = 1;
+      for (int level = m_bank_level; level > 0; level--) {
+        m_bank_strides[level] = m_num_banks;
+        m_num_banks *= m_dram->m_organization.count[level];
+      }
+      m_bank_num_outstanding.resize(m_num_banks, 0);
+
+      m_read_cmd = m_dram->m_request_translations(Request::Type::Read);
+      m_write_cmd = m_dram->m_request_translations(Request::Type::Write);
+      for (auto name : {"nBL", "nBL16"}) {
+        if (m_dram->m_timings.contains(name)) {
+          m_burst_cycles = std::max(m_dram->m_timing_vals(name), 1);
+          break;
+        }
+      }
+
+      const auto& timing_cons = m_dram->m_timing_cons;
+      for (int level = 0; level < timing_cons.num_levels(); level++) {
+        for (const auto& t : timing_cons.plain(level, m_write_cmd)) {
+          if (t.cmd == m_read_cmd) {
+            m_wtr_latency = std::max(m_wtr_latency, t.val);
+          }
+        }
+        for (const auto& t : timing_cons.plain(level, m_read_cmd)) {
+          if (t.cmd == m_write_cmd) {
+            m_rtw_latency = std::max(m_rtw_latency, t.val);
+          }
+        }
+        for (int cmd = 0; cmd < timing_cons.num_commands(); cmd++) {
+          for (const auto& t : timing_cons.windowed(level, cmd)) {
+            if (t.window > 1 && m_dram->m_command_meta(cmd).is_opening && m_dram->m_command_meta(t.cmd).is_opening && t.val > m_faw_latency) {
+              m_faw_level = level;
+              m_faw_window = t.window;
+              m_faw_latency = t.val;
+            }
+          }
+        }
+      }
+      int num_faw_nodes = 1;
+      for (int level = 1; level <= m_faw_level; level++) {
+        num_faw_nodes *= m_dram->m_organization.count[level];
+      }
+      m_act_history.resize(num_faw_nodes);
+
+      impl->register_stat(s_data_bus_busy_cycles).name("data_bus_busy_cycles_{}", channel_id);
+      impl->register_stat(s_cmd_bus_busy_cycles).name("cmd_bus_busy_cycles_{}", channel_id);
+      impl->register_stat(s_idle_cycles_refresh).name("idle_cycles_refresh_{}", channel_id);
+      impl->register_stat(s_idle_cycles_rw_turnaround).name("idle_cycles_rw_turnaround_{}", channel_id);
+      impl->register_stat(s_idle_cycles_faw).name("idle_cycles_faw_{}", channel_id);
+      impl->register_stat(s_idle_cycles_no_request).name("idle_cycles_no_request_{}", channel_id);
+      impl->register_stat(s_idle_cycles_rh_mitigation).name("idle_cycles_rh_mitigation_{}", channel_id);
+      impl->register_stat(s_idle_cycles_other).name("idle_cycles_other_{}", channel_id);
+      impl->register_stat(s_num_rw_switches).name("num_rw_switches_{}", channel_id);
+      impl->register_stat(s_avg_bank_parallelism).name("avg_bank_parallelism_{}", channel_id);
+      impl->register_stat(s_bandwidth).name("bandwidth_GBps_{}", channel_id);
+      impl->register_stat(s_peak_bandwidth).name("peak_bandwidth_GBps_{}", channel_id);
+      impl->register_stat(s_data_bus_utilization).name("data_bus_utilization_pct_{}", channel_id);
+      impl->register_stat(s_cmd_bus_utilization).name("cmd_bus_utilization_pct_{}", channel_id);
+    }
+
+    /**
+     * @brief    Tracks the number of outstanding (i.e., enqueued and not yet served) read/write requests of each bank.
+     */
+    void add_outstanding(const AddrVec_t& addr_vec, int delta) {
+      int flat_bank_id = 0;
+      for (int level = 1; level <= m_bank_level; level++) {
+        flat_bank_id += std::max(addr_vec[level], 0) * m_bank_strides[level];
+      }
+      int& num_outstanding = m_bank_num_outstanding[flat_bank_id];
+      if (num_outstanding == 0) {
+        m_num_active_banks++;
+      }
+      num_outstanding += delta;
+      if (num_outstanding == 0) {
+        m_num_active_banks--;
+      }
+    }
+
+    void count_rw_switch() {
+      s_num_rw_switches++;
+    }
+
+    /**
+     * @brief    Accounts the data/command bus occupancy and the bank-level parallelism of this cycle.
+     * @details
+     * Must be called once per cycle before the command is issued (i.e., while req_it is still valid).
+     * Returns whether the data bus is idle in this cycle.
+     */
+    bool update(bool request_found, ReqBuffer::iterator& req_it) {
+      m_clk++;
+
+      // Bank-level parallelism: number of distinct banks with outstanding requests
+      if (m_num_active_banks > 0) {
+        s_active_banks += m_num_active_banks;
+        s_active_bank_cycles++;
+      }
+
+      // Bus occupancy of the command issued in this cycle
+      if (request_found) {
+        int command = req_it->command;
+        s_cmd_bus_busy_cycles++;
+        if (m_dram->m_command_meta(command).is_accessing) {
+          Clk_t burst_end = m_clk + m_burst_cycles;
+          s_data_bus_busy_cycles += burst_end - std::max(m_clk, m_data_bus_busy_until);
+          m_data_bus_busy_until = burst_end;
+        }
+        if (command == m_read_cmd) {
+          m_last_read_clk = m_clk;
+        } else if (command == m_write_cmd) {
+          m_last_write_clk = m_clk;
+        }
+        if (m_faw_window > 1 && m_dram->m_command_meta(command).is_opening) {
+          auto& history = m_act_history[get_faw_node_id(req_it->addr_vec)];
+          history.push_back(m_clk);
+          if (history.size() > m_faw_window) {
+            history.pop_front();
+          }
+        }
+      }
+
+      return m_clk >= m_data_bus_busy_until;
+    }
+
+    /**
+     * @brief    Attributes a cycle with an idle data bus to exactly one cause.
+     * @details
+     * The causes are checked in this order: maintenance requests at the head of the priority buffer (refresh,
+     * or RowHammer mitigation for everything else), no outstanding request, requests held back to mitigate
+     * RowHammer (e.g., by a throttling scheduler), read/write turnaround, four-activation window, and everything
+     * else. The oldest request of the buffer being served tells which constraint holds it back.
+     */
+    void attribute_idle_cycle(const ReqBuffer& priority_buffer, bool has_requests, bool is_mitigating, const ReqBuffer& serving_buffer) {
+      if (priority_buffer.size() != 0) {
+        if (m_dram->m_command_meta(priority_buffer.buffer.front().final_command).is_refreshing) {
+          s_idle_cycles_refresh++;
+        } else {
+          s_idle_cycles_rh_mitigation++;
+        }
+        return;
+      }
+
+      if (!has_requests) {
+        s_idle_cycles_no_request++;
+        return;
+      }
+
+      if (is_mitigating) {
+        s_idle_cycles_rh_mitigation++;
+        return;
+      }
+
+      if (serving_buffer.size() == 0) {
+        s_idle_cycles_other++;
+        return;
+      }
+      const Request& req = serving_buffer.buffer.front();
+      int command = req.command;
+      if (command == m_read_cmd && m_last_write_clk >= 0 && m_clk < m_last_write_clk + m_wtr_latency) {
+        s_idle_cycles_rw_turnaround++;
+      } else if (command == m_write_cmd && m_last_read_clk >= 0 && m_clk < m_last_read_clk + m_rtw_latency) {
+        s_idle_cycles_rw_turnaround++;
+      } else if (command >= 0 && m_faw_window > 1 && m_dram->m_command_meta(command).is_opening && is_faw_blocked(req.addr_vec)) {
+        s_idle_cycles_faw++;
+      } else {
+        s_idle_cycles_other++;
+      }
+    }
+
+    void finalize() {
+      Clk_t num_cycles = std::max<Clk_t>(m_clk, 1);
+      s_avg_bank_parallelism = s_active_bank_cycles ? (float) s_active_banks / (float) s_active_bank_cycles : 0.0f;
+      s_data_bus_utilization = 100.0f * (float) s_data_bus_busy_cycles / (float) num_cycles;
+      s_cmd_bus_utilization = 100.0f * (float) s_cmd_bus_busy_cycles / (float) num_cycles;
+
+      // Bytes moved per access = internal prefetch (burst length) x channel width
+      if (m_dram->m_timings.contains("tCK_ps") && m_dram->m_channel_width > 0) {
+        double tCK_ps = m_dram->m_timing_vals("tCK_ps");
+        double access_bytes = (double) m_dram->m_internal_prefetch_size * m_dram->m_channel_width / 8;
+        double num_accesses = (double) s_data_bus_busy_cycles / m_burst_cycles;
+        // bytes / ps = TB/s, hence the factor of 1000 to get GB/s
+        s_bandwidth = access_bytes * num_accesses / ((double) num_cycles * tCK_ps) * 1000;
+        s_peak_bandwidth = access_bytes / ((double) m_burst_cycles * tCK_ps) * 1000;
+      }
+    }
+
+  private:
+    int get_faw_node_id(const AddrVec_t& addr_vec) const {
+      int flat_id = 0;
+      int stride = 1;
+      for (int level = m_faw_level; level > 0; level--) {
+        flat_id += std::max(addr_vec[level], 0) * stride;
+        stride *= m_dram->m_organization.count[level];
+      }
+      return flat_id;
+    }
+
+    bool is_faw_blocked(const AddrVec_t& addr_vec) const {
+      const auto& history = m_act_history[get_faw_node_id(addr_vec)];
+      return history.size() == m_faw_window && m_clk < history.front() + m_faw_latency;
+    }
+};
+
+}       // namespace Ramulator
+
+#endif  // RAMULATOR_CONTROLLER_UTILIZATION_STATS_H
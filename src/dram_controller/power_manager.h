@@ -0,0 +1,41 @@
+#ifndef     RAMULATOR_CONTROLLER_POWER_MANAGER_H
+#define     RAMULATOR_CONTROLLER_POWER_MANAGER_H
+
+#include <vector>
+#include <string>
+
+#include "base/base.h"
+
+
+namespace Ramulator {
+
+class IDRAMController;
+
+class IPowerManager {
+  RAMULATOR_REGISTER_INTERFACE(IPowerManager, "PowerManager", "Power-Down and Self-Refresh Manager Interface.");
+  protected:
+    IDRAMController* m_ctrl = nullptr;
+
+  public:
+    /**
+     * @brief    Called before the controller schedules a request, e.g., to send power-down or self-refresh entry requests.
+     */
+    virtual void tick() = 0;
+
+    /**
+     * @brief    Called after the controller has scheduled a request, to observe the command about to be issued.
+     */
+    virtual void update(bool request_found, ReqBuffer::iterator& req_it) = 0;
+
+    /**
+     * @brief    Called before the controller serves the request at the head of the priority buffer. Returns true if it is a
+     *           low-power entry that no longer applies (e.g., requests arrived at its rank since it was sent), which the
+     *           controller then drops.
+     */
+    virtual bool is_stale(const Request& req) { return false; };
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_CONTROLLER_POWER_MANAGER_H
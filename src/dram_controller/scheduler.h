@@ -16,6 +16,24 @@ class IScheduler {
     virtual ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) = 0;
 
     virtual ReqBuffer::iterator get_best_request(ReqBuffer& buffer) = 0;
+
+    /**
+     * @brief    Called once per controller cycle with the scheduling decision, before the command is issued.
+     * @details
+     * Schedulers that keep state across cycles (e.g., batches, thread ranks) use this to observe
+     * which request was served. Stateless schedulers can ignore it.
+     *
+     */
+    virtual void update(bool request_found, ReqBuffer::iterator& req_it) {};
+
+    /**
+     * @brief    Called when a read/write request enters the controller (on_enqueue) and when its last command is issued (on_retire).
+     * @details
+     * Lets schedulers keep per-core or per-bank bookkeeping incrementally instead of rescanning the buffers every cycle.
+     *
+     */
+    virtual void on_enqueue(const Request& req) {};
+    virtual void on_retire(const Request& req) {};
 };
 
 }       // namespace Ramulator
@@ -0,0 +1,144 @@
+#include "frontend/impl/external_wrapper/batched_external.h"
+
+namespace Ramulator {
+
+BatchedExternal::~BatchedExternal() {
+  stop_worker();
+}
+
+void BatchedExternal::init() {
+  m_threaded = param<bool>("threaded").desc("Whether to tick the memory system on its own thread.").default_val(false);
+  int queue_capacity = param<int>("queue_capacity").desc("Capacity of the submission and completion queues.").default_val(1024);
+  if (queue_capacity <= 0) {
+    throw ConfigurationError("[BatchedExternal] The queue capacity ({}) must be positive!", queue_capacity);
+  }
+
+  if (m_threaded) {
+    m_submissions = std::make_unique<SPSCQueue<ExternalRequest>>(queue_capacity);
+  }
+  m_completions = std::make_unique<SPSCQueue<Completion>>(queue_capacity);
+  m_callback = [this](Request& req) { complete(req); };
+
+  register_stat(s_num_read_requests).name("num_read_requests");
+  register_stat(s_num_write_requests).name("num_write_requests");
+  register_stat(s_num_completions).name("num_completions");
+}
+
+void BatchedExternal::finalize() {
+  stop_worker();
+  IFrontEnd::finalize();
+}
+
+size_t BatchedExternal::send(const ExternalRequest* reqs, size_t num_reqs) {
+  if (m_threaded) {
+    return m_submissions->push(reqs, num_reqs);
+  }
+
+  size_t num_sent = 0;
+  while (num_sent < num_reqs && send_request(reqs[num_sent])) {
+    num_sent++;
+  }
+  return num_sent;
+}
+
+size_t BatchedExternal::poll(Completion* completions, size_t max_completions) {
+  if (!m_threaded) {
+    flush_overflow();
+  }
+  return m_completions->pop(completions, max_completions);
+}
+
+void BatchedExternal::advance(Clk_t num_cycles) {
+  if (!m_threaded) {
+    for (Clk_t i = 0; i < num_cycles; i++) {
+      run_cycle();
+    }
+    return;
+  }
+
+  if (!m_worker.joinable()) {
+    m_worker = std::thread([this]() {
+      Clk_t done_clk = m_done_clk.load(std::memory_order_relaxed);
+      while (!m_stop.load(std::memory_order_acquire)) {
+        if (done_clk < m_target_clk.load(std::memory_order_acquire)) {
+          run_cycle();
+          m_done_clk.store(++done_clk, std::memory_order_release);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  m_target_clk.fetch_add(num_cycles, std::memory_order_release);
+}
+
+void BatchedExternal::sync() {
+  if (!m_threaded) {
+    return;
+  }
+  while (m_done_clk.load(std::memory_order_acquire) < m_target_clk.load(std::memory_order_relaxed)) {
+    std::this_thread::yield();
+  }
+}
+
+bool BatchedExternal::receive_external_requests(int req_type_id, Addr_t addr, int source_id, std::function<void(Request&)> callback) {
+  if (m_threaded) {
+    throw std::runtime_error("[BatchedExternal] Single requests with callbacks are not supported in the threaded mode!");
+  }
+  return m_memory_system->send({addr, req_type_id, source_id, callback});
+}
+
+bool BatchedExternal::send_request(const ExternalRequest& ext_req) {
+  Request req(ext_req.addr, ext_req.type_id, ext_req.source_id, m_callback);
+  req.m_payload = ext_req.tag;
+  if (!m_memory_system->send(req)) {
+    return false;
+  }
+
+  if (ext_req.type_id == Request::Type::Read) {
+    s_num_read_requests++;
+  } else if (ext_req.type_id == Request::Type::Write) {
+    s_num_write_requests++;
+  }
+  return true;
+}
+
+void BatchedExternal::complete(Request& req) {
+  Completion completion {req.m_payload, req.type_id, req.arrive, req.depart};
+  if (!m_overflow.empty() || !m_completions->push(completion)) {
+    m_overflow.push_back(completion);
+  }
+  s_num_completions++;
+}
+
+void BatchedExternal::flush_overflow() {
+  while (!m_overflow.empty() && m_completions->push(m_overflow.front())) {
+    m_overflow.pop_front();
+  }
+}
+
+void BatchedExternal::run_cycle() {
+  flush_overflow();
+
+  if (m_threaded) {
+    while (ExternalRequest* ext_req = m_submissions->front()) {
+      if (!send_request(*ext_req)) {
+        break;
+      }
+      m_submissions->pop();
+    }
+  }
+
+  m_memory_system->tick();
+  m_clk++;
+}
+
+void BatchedExternal::stop_worker() {
+  if (m_worker.joinable()) {
+    sync();
+    m_stop.store(true, std::memory_order_release);
+    m_worker.join();
+  }
+}
+
+}        // namespace Ramulator
@@ -0,0 +1,109 @@
+#ifndef     RAMULATOR_FRONTEND_EXTERNAL_WRAPPER_BATCHED_EXTERNAL_H
+#define     RAMULATOR_FRONTEND_EXTERNAL_WRAPPER_BATCHED_EXTERNAL_H
+
+#include <deque>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+#include "base/base.h"
+#include "base/spsc_queue.h"
+#include "frontend/frontend.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Frontend for embedding Ramulator in another simulator (e.g., gem5 or an NDP/GPU simulator) that exchanges
+ *           requests and completions in batches.
+ * @details
+ * The host submits requests with send(), advances the memory system with advance(), and collects the completions
+ * with poll(). A request carries an opaque tag (e.g., the host's packet pointer) that comes back with its completion,
+ * so no per-request callback is allocated. The completions go through a ring buffer.
+ *
+ * In the threaded mode (threaded: true), the memory system is ticked by a worker thread: send() only pushes to a
+ * lock-free submission queue that the worker drains at the start of every cycle (retrying the requests the memory
+ * system rejects, in order), advance() returns immediately, and sync() waits for the worker to catch up. Calling
+ * sync() before send() and poll() in every host cycle gives the same results as the single-threaded mode while the
+ * memory system runs concurrently with the rest of the host cycle.
+ */
+class BatchedExternal final : public IFrontEnd, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, BatchedExternal, "BatchedExternal", "Batched external request frontend for embedding Ramulator.")
+
+  public:
+    struct ExternalRequest {
+      Addr_t addr;
+      int type_id;
+      int source_id;
+      void* tag;
+    };
+
+    struct Completion {
+      void* tag;
+      int type_id;
+      Clk_t arrive;
+      Clk_t depart;
+    };
+
+  private:
+    bool m_threaded = false;
+
+    std::unique_ptr<SPSCQueue<ExternalRequest>> m_submissions;    // Threaded mode only
+    std::unique_ptr<SPSCQueue<Completion>> m_completions;
+    std::deque<Completion> m_overflow;          // Completions that did not fit in the ring buffer yet
+    std::function<void(Request&)> m_callback;   // Shared by all requests
+
+    std::thread m_worker;
+    std::atomic<Clk_t> m_target_clk {0};       // The number of memory cycles requested by advance()
+    std::atomic<Clk_t> m_done_clk {0};         // The number of memory cycles done by the worker
+    std::atomic<bool> m_stop {false};
+
+    size_t s_num_read_requests = 0;
+    size_t s_num_write_requests = 0;
+    size_t s_num_completions = 0;
+
+  public:
+    ~BatchedExternal();
+
+    void init() override;
+    void tick() override { };
+    void finalize() override;
+
+    /**
+     * @brief    Submits up to num_reqs requests in order and returns how many were accepted
+     * @details
+     * In the single-threaded mode, a request is accepted if the memory system accepts it. In the threaded mode, it is
+     * accepted if it fits in the submission queue.
+     */
+    size_t send(const ExternalRequest* reqs, size_t num_reqs);
+
+    /**
+     * @brief    Pops up to max_completions completions into completions and returns how many were popped
+     */
+    size_t poll(Completion* completions, size_t max_completions);
+
+    /**
+     * @brief    Ticks the memory system num_cycles times (in the threaded mode, asynchronously)
+     */
+    void advance(Clk_t num_cycles = 1);
+
+    /**
+     * @brief    Waits until the memory system has done all cycles requested by advance()
+     */
+    void sync();
+
+    bool receive_external_requests(int req_type_id, Addr_t addr, int source_id, std::function<void(Request&)> callback) override;
+
+  private:
+    bool send_request(const ExternalRequest& ext_req);
+    void complete(Request& req);
+    void flush_overflow();
+    void run_cycle();
+    void stop_worker();
+
+    bool is_finished() override { return true; };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_FRONTEND_EXTERNAL_WRAPPER_BATCHED_EXTERNAL_H
@@ -0,0 +1,236 @@
+#include <filesystem>
+#include <iostream>
+#include <fstream>
+
+#include "frontend/frontend.h"
+#include "frontend/impl/memory_trace/miss_trace.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief    Replays an LLC miss trace captured by SimpleO3 (llc_capture_path) without modeling the cores and the LLC.
+ * @details
+ * In the open-loop mode, every request is sent in the cycle it was captured in (or as soon as the memory system
+ * accepts it, in the captured order).
+ *
+ * In the closed-loop mode, each core (and the writebacks) replays its own requests in order. A request is sent once
+ *   1) as many cycles as separated it from the previous request of the core in the capture have passed since that
+ *      request was sent,
+ *   2) the read it depends on (i.e., the last read of the core that had completed when it was captured) has completed,
+ *   3) the core has fewer than mshr_per_core reads in flight (reads only),
+ * so a faster or slower memory system speeds up or slows down the replay like it would the cores.
+ */
+class MissTrace : public IFrontEnd, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, MissTrace, "MissTrace", "Replays a captured LLC miss trace.")
+
+  private:
+    struct Stream {
+      std::vector<size_t> records;    // The indices of the records of the stream
+      size_t pos = 0;                 // The next record to send
+      Clk_t last_send_clk = 0;
+      int num_outstanding = 0;
+    };
+
+    std::vector<MissTraceRecord> m_trace;
+    std::vector<bool> m_completed;
+    size_t m_curr_trace_idx = 0;      // Open loop only
+    size_t m_num_sent = 0;
+    size_t m_num_outstanding = 0;
+
+    int m_num_cores = 1;
+    bool m_closed_loop = false;
+    int m_mshr_per_core = 16;
+    std::vector<Stream> m_streams;    // One per core and one for the writebacks (closed loop only)
+
+    Logger_t m_logger;
+
+    size_t s_num_read_requests = 0;
+    size_t s_num_write_requests = 0;
+    size_t s_issue_delay = 0;
+    size_t s_read_latency = 0;
+    Clk_t s_captured_cycles = 0;
+    float s_avg_issue_delay = 0;
+    float s_avg_read_latency = 0;
+
+  public:
+    void init() override {
+      std::string trace_path_str = param<std::string>("path").desc("Path to the LLC miss trace file.").required();
+
+      m_logger = Logging::create_logger("MissTrace");
+      m_logger->info("Loading trace file {} ...", trace_path_str);
+      MissTraceHeader header = init_trace(trace_path_str);
+      m_logger->info("Loaded {} requests of {} cores.", m_trace.size(), header.num_cores);
+
+      m_clock_ratio = param<uint>("clock_ratio").desc("Defaults to the clock ratio of the captured frontend.").default_val(header.clock_ratio);
+      m_closed_loop = param<bool>("closed_loop").desc("Whether to replay the requests of each core as they become ready instead of at their cycles.").default_val(false);
+      m_mshr_per_core = param<int>("mshr_per_core").desc("Max number of reads in flight per core in the closed-loop mode.").default_val(16);
+
+      m_num_cores = header.num_cores;
+      if (m_closed_loop) {
+        if (m_mshr_per_core <= 0) {
+          throw ConfigurationError("[MissTrace] Each core must allow at least one read in flight!");
+        }
+        m_streams.resize(m_num_cores + 1);
+        for (size_t idx = 0; idx < m_trace.size(); idx++) {
+          m_streams[get_stream(m_trace[idx])].records.push_back(idx);
+        }
+      }
+
+      register_stat(m_clk).name("cycles");
+      register_stat(s_captured_cycles).name("captured_cycles");
+      register_stat(s_num_read_requests).name("num_read_requests");
+      register_stat(s_num_write_requests).name("num_write_requests");
+      register_stat(s_avg_issue_delay).name("avg_issue_delay");
+      register_stat(s_avg_read_latency).name("avg_read_latency");
+    };
+
+
+    void tick() override {
+      m_clk++;
+
+      if (!m_closed_loop) {
+        while (m_curr_trace_idx < m_trace.size() && m_trace[m_curr_trace_idx].cycle <= m_clk) {
+          if (!send(m_curr_trace_idx)) {
+            break;
+          }
+          m_curr_trace_idx++;
+        }
+        return;
+      }
+
+      for (auto& stream : m_streams) {
+        while (stream.pos < stream.records.size()) {
+          size_t idx = stream.records[stream.pos];
+          const MissTraceRecord& record = m_trace[idx];
+
+          Clk_t ready_clk = record.cycle;
+          if (stream.pos > 0) {
+            ready_clk = stream.last_send_clk + (record.cycle - m_trace[stream.records[stream.pos - 1]].cycle);
+          }
+          if (m_clk < ready_clk) {
+            break;
+          }
+          if (record.dep >= 0 && !m_completed[record.dep]) {
+            break;
+          }
+          if (record.type_id == Request::Type::Read && stream.num_outstanding >= m_mshr_per_core) {
+            break;
+          }
+          if (!send(idx)) {
+            break;
+          }
+          stream.pos++;
+          stream.last_send_clk = m_clk;
+        }
+      }
+    };
+
+    void finalize() override {
+      s_avg_issue_delay = m_num_sent ? (float) s_issue_delay / m_num_sent : 0;
+      s_avg_read_latency = s_num_read_requests ? (float) s_read_latency / s_num_read_requests : 0;
+
+      IFrontEnd::finalize();
+    };
+
+    int get_num_cores() override {
+      return m_num_cores;
+    };
+
+
+  private:
+    int get_stream(const MissTraceRecord& record) {
+      return record.source_id >= 0 ? record.source_id : m_num_cores;
+    };
+
+    bool send(size_t idx) {
+      const MissTraceRecord& record = m_trace[idx];
+
+      bool request_sent = false;
+      if (record.type_id == Request::Type::Read) {
+        request_sent = m_memory_system->send({record.addr, record.type_id, record.source_id,
+          [this, idx, issue_clk = m_clk](Request& req) { receive(idx, issue_clk); }
+        });
+      } else {
+        request_sent = m_memory_system->send({record.addr, record.type_id, record.source_id, nullptr});
+      }
+      if (!request_sent) {
+        return false;
+      }
+
+      if (record.type_id == Request::Type::Read) {
+        s_num_read_requests++;
+        m_num_outstanding++;
+        if (m_closed_loop) {
+          m_streams[get_stream(record)].num_outstanding++;
+        }
+      } else {
+        s_num_write_requests++;
+      }
+      s_issue_delay += std::max<Clk_t>(m_clk - record.cycle, 0);
+      m_num_sent++;
+      return true;
+    };
+
+    void receive(size_t idx, Clk_t issue_clk) {
+      m_completed[idx] = true;
+      m_num_outstanding--;
+      if (m_closed_loop) {
+        m_streams[get_stream(m_trace[idx])].num_outstanding--;
+      }
+      s_read_latency += m_clk - issue_clk;
+    };
+
+    MissTraceHeader init_trace(const std::string& file_path_str) {
+      fs::path trace_path(file_path_str);
+      if (!fs::exists(trace_path)) {
+        throw ConfigurationError("Trace {} does not exist!", file_path_str);
+      }
+
+      std::ifstream trace_file(trace_path, std::ios::in | std::ios::binary);
+      if (!trace_file.is_open()) {
+        throw ConfigurationError("Trace {} cannot be opened!", file_path_str);
+      }
+
+      MissTraceHeader header;
+      trace_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+      if (!trace_file || header.magic != MissTraceHeader::MAGIC) {
+        throw ConfigurationError("Trace {} is not an LLC miss trace!", file_path_str);
+      }
+      if (header.num_cores <= 0) {
+        throw ConfigurationError("Trace {} has an invalid number of cores ({})!", file_path_str, header.num_cores);
+      }
+
+      size_t num_records = (fs::file_size(trace_path) - sizeof(header)) / sizeof(MissTraceRecord);
+      m_trace.resize(num_records);
+      trace_file.read(reinterpret_cast<char*>(m_trace.data()), num_records * sizeof(MissTraceRecord));
+      if (!trace_file) {
+        throw ConfigurationError("Trace {} is truncated!", file_path_str);
+      }
+      trace_file.close();
+
+      for (size_t idx = 0; idx < num_records; idx++) {
+        const MissTraceRecord& record = m_trace[idx];
+        if (record.source_id < -1 || record.source_id >= header.num_cores) {
+          throw ConfigurationError("Record {} of trace {} is from core {}, but the trace has {} cores!", idx, file_path_str, record.source_id, header.num_cores);
+        }
+        if (record.dep >= (int64_t) idx) {
+          throw ConfigurationError("Record {} of trace {} depends on a later record ({})!", idx, file_path_str, record.dep);
+        }
+      }
+
+      m_completed.resize(num_records, false);
+      if (num_records > 0) {
+        s_captured_cycles = m_trace.back().cycle;
+      }
+      return header;
+    };
+
+    bool is_finished() override {
+      return m_num_sent >= m_trace.size() && m_num_outstanding == 0;
+    };
+};
+
+}        // namespace Ramulator
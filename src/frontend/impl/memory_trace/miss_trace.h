@@ -0,0 +1,32 @@
+#ifndef     RAMULATOR_FRONTEND_MEMORY_TRACE_MISS_TRACE_H
+#define     RAMULATOR_FRONTEND_MEMORY_TRACE_MISS_TRACE_H
+
+#include <cstdint>
+
+namespace Ramulator {
+
+/**
+ * @brief    Binary format of the LLC miss traces captured by SimpleO3 and replayed by MissTrace
+ * @details
+ * The file is a MissTraceHeader followed by one MissTraceRecord per request sent to the memory system, in the order
+ * they were sent. Records are written and read as they are in memory (i.e., in the host's byte order).
+ */
+struct MissTraceHeader {
+  static constexpr uint64_t MAGIC = 0x3152544d52415200;    // Identifies the file format (and its version)
+
+  uint64_t magic = MAGIC;
+  uint32_t clock_ratio = 1;     // The clock ratio of the captured frontend
+  int32_t  num_cores = 1;
+};
+
+struct MissTraceRecord {
+  int64_t cycle;     // The frontend cycle in which the request was sent
+  int64_t addr;
+  int32_t type_id;
+  int32_t source_id; // The core that caused the miss (-1 for writebacks)
+  int64_t dep;       // The index of the last read of the core that had completed when the request was sent (-1 if none)
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_FRONTEND_MEMORY_TRACE_MISS_TRACE_H
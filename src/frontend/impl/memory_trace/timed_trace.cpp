@@ -0,0 +1,225 @@
+#include <filesystem>
+#include <iostream>
+#include <fstream>
+#include <cmath>
+
+#include "frontend/frontend.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief    Replays a load/store trace at the times given by its timestamps.
+ * @details
+ * Each line of the trace is "<time> LD|ST <addr>", where the time (in frontend cycles) is either the absolute
+ * time of the request or the gap since the previous request (timestamp_mode: delta). The times are scaled by
+ * time_scale, so the same trace can be replayed at a higher or lower offered load.
+ *
+ * Every cycle, up to issue_width requests whose time has come are sent in trace order. Reads are tracked until their
+ * callback is called and at most max_outstanding of them can be in flight, writes are posted. A request that cannot
+ * be sent (i.e., the window is full or the memory system rejects it) stalls the ones behind it, which shows up as the
+ * achieved load falling behind the offered load.
+ */
+class TimedTrace : public IFrontEnd, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, TimedTrace, "TimedTrace", "Timestamped load/store memory address trace replayed at its own rate.")
+
+  private:
+    struct Trace {
+      Clk_t time;
+      bool is_write;
+      Addr_t addr;
+    };
+    std::vector<Trace> m_trace;
+
+    size_t m_trace_length = 0;
+    size_t m_curr_trace_idx = 0;
+
+    int m_issue_width = 1;
+    int m_max_outstanding = 0;
+    int m_num_outstanding = 0;
+
+    Clk_t m_last_issue_clk = 0;
+
+    Logger_t m_logger;
+
+    size_t s_num_read_requests = 0;
+    size_t s_num_write_requests = 0;
+    size_t s_num_completed_reads = 0;
+    size_t s_window_stall_cycles = 0;
+    size_t s_rejected_cycles = 0;
+    size_t s_issue_delay = 0;
+    size_t s_read_latency = 0;
+    float s_avg_issue_delay = 0;
+    float s_avg_read_latency = 0;
+    float s_offered_load = 0;
+    float s_achieved_load = 0;
+
+  public:
+    void init() override {
+      std::string trace_path_str = param<std::string>("path").desc("Path to the timestamped load store trace file.").required();
+      m_clock_ratio = param<uint>("clock_ratio").required();
+
+      std::string timestamp_mode = param<std::string>("timestamp_mode").desc("Whether the times are absolute (\"absolute\") or inter-arrival gaps (\"delta\").").default_val("absolute");
+      double time_scale = param<double>("time_scale").desc("Scales the times of the trace (e.g., 0.5 replays it at twice the offered load).").default_val(1.0);
+      m_issue_width = param<int>("issue_width").desc("Max number of requests sent per cycle.").default_val(1);
+      m_max_outstanding = param<int>("max_outstanding").desc("Max number of reads in flight (0 for unlimited).").default_val(0);
+
+      if (timestamp_mode != "absolute" && timestamp_mode != "delta") {
+        throw ConfigurationError("[TimedTrace] Unknown timestamp mode {}!", timestamp_mode);
+      }
+      if (time_scale < 0) {
+        throw ConfigurationError("[TimedTrace] The time scale ({}) cannot be negative!", time_scale);
+      }
+      if (m_issue_width <= 0) {
+        throw ConfigurationError("[TimedTrace] The issue width ({}) must be positive!", m_issue_width);
+      }
+
+      m_logger = Logging::create_logger("TimedTrace");
+      m_logger->info("Loading trace file {} ...", trace_path_str);
+      init_trace(trace_path_str, timestamp_mode == "delta", time_scale);
+      m_logger->info("Loaded {} lines.", m_trace.size());
+
+      register_stat(m_clk).name("cycles");
+      register_stat(s_num_read_requests).name("num_read_requests");
+      register_stat(s_num_write_requests).name("num_write_requests");
+      register_stat(s_num_completed_reads).name("num_completed_reads");
+      register_stat(s_window_stall_cycles).name("window_stall_cycles");
+      register_stat(s_rejected_cycles).name("rejected_cycles");
+      register_stat(s_avg_issue_delay).name("avg_issue_delay");
+      register_stat(s_avg_read_latency).name("avg_read_latency");
+      register_stat(s_offered_load).name("offered_load");
+      register_stat(s_achieved_load).name("achieved_load");
+    };
+
+
+    void tick() override {
+      m_clk++;
+      // The time of this cycle in the trace (the first cycle is time 0)
+      Clk_t now = m_clk - 1;
+
+      for (int i = 0; i < m_issue_width && m_curr_trace_idx < m_trace_length; i++) {
+        const Trace& t = m_trace[m_curr_trace_idx];
+        if (t.time > now) {
+          break;
+        }
+
+        if (!t.is_write && m_max_outstanding > 0 && m_num_outstanding >= m_max_outstanding) {
+          s_window_stall_cycles++;
+          break;
+        }
+
+        bool request_sent = false;
+        if (t.is_write) {
+          request_sent = m_memory_system->send({t.addr, Request::Type::Write});
+        } else {
+          request_sent = m_memory_system->send({t.addr, Request::Type::Read, 0, [this, issue_clk = m_clk](Request& req) { receive(req, issue_clk); }});
+        }
+        if (!request_sent) {
+          s_rejected_cycles++;
+          break;
+        }
+
+        if (t.is_write) {
+          s_num_write_requests++;
+        } else {
+          s_num_read_requests++;
+          m_num_outstanding++;
+        }
+        s_issue_delay += now - t.time;
+        m_last_issue_clk = now;
+        m_curr_trace_idx++;
+      }
+    };
+
+    void finalize() override {
+      size_t num_requests = s_num_read_requests + s_num_write_requests;
+      s_avg_issue_delay = num_requests ? (float) s_issue_delay / num_requests : 0;
+      s_avg_read_latency = s_num_completed_reads ? (float) s_read_latency / s_num_completed_reads : 0;
+
+      // Requests per cycle over the span of the trace, and over the time it actually took to send them
+      if (m_trace_length > 0) {
+        Clk_t start = m_trace.front().time;
+        s_offered_load = (float) m_trace_length / (m_trace.back().time - start + 1);
+        s_achieved_load = (float) num_requests / (std::max(m_last_issue_clk, start) - start + 1);
+      }
+
+      IFrontEnd::finalize();
+    };
+
+
+  private:
+    void receive(Request& req, Clk_t issue_clk) {
+      m_num_outstanding--;
+      s_num_completed_reads++;
+      s_read_latency += m_clk - issue_clk;
+    };
+
+    void init_trace(const std::string& file_path_str, bool is_delta, double time_scale) {
+      fs::path trace_path(file_path_str);
+      if (!fs::exists(trace_path)) {
+        throw ConfigurationError("Trace {} does not exist!", file_path_str);
+      }
+
+      std::ifstream trace_file(trace_path);
+      if (!trace_file.is_open()) {
+        throw ConfigurationError("Trace {} cannot be opened!", file_path_str);
+      }
+
+      std::string line;
+      size_t line_number = 0;
+      double time = 0;
+      while (std::getline(trace_file, line)) {
+        line_number++;
+        std::vector<std::string> tokens;
+        tokenize(tokens, line, " ");
+        if (tokens.empty()) {
+          continue;
+        }
+
+        if (tokens.size() != 3) {
+          throw ConfigurationError("Trace {} format invalid at line {}!", file_path_str, line_number);
+        }
+
+        double timestamp = std::stod(tokens[0]);
+        if (is_delta) {
+          if (timestamp < 0) {
+            throw ConfigurationError("Trace {} has a negative gap at line {}!", file_path_str, line_number);
+          }
+          time += timestamp;
+        } else if (timestamp < time) {
+          throw ConfigurationError("Trace {} timestamps are not in order at line {}!", file_path_str, line_number);
+        } else {
+          time = timestamp;
+        }
+
+        bool is_write = false;
+        if (tokens[1] == "LD") {
+          is_write = false;
+        } else if (tokens[1] == "ST") {
+          is_write = true;
+        } else {
+          throw ConfigurationError("Trace {} format invalid at line {}!", file_path_str, line_number);
+        }
+
+        Addr_t addr = -1;
+        if (tokens[2].compare(0, 2, "0x") == 0 || tokens[2].compare(0, 2, "0X") == 0) {
+          addr = std::stoll(tokens[2].substr(2), nullptr, 16);
+        } else {
+          addr = std::stoll(tokens[2]);
+        }
+        m_trace.push_back({(Clk_t) std::llround(time * time_scale), is_write, addr});
+      }
+
+      trace_file.close();
+
+      m_trace_length = m_trace.size();
+    };
+
+    bool is_finished() override {
+      return m_curr_trace_idx >= m_trace_length && m_num_outstanding == 0;
+    };
+};
+
+}        // namespace Ramulator
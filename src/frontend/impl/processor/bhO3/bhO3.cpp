@@ -130,6 +130,8 @@ bool BHO3::is_finished() {
 
 void BHO3::connect_memory_system(IMemorySystem* memory_system) {
   m_llc->connect_memory_system(memory_system);
+  // Set up the components (e.g., the translation)
+  IFrontEnd::connect_memory_system(memory_system);
 };
 
 int BHO3::get_num_cores() {
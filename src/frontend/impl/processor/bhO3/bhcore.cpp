@@ -118,6 +118,8 @@ m_llc(llc), m_lat_hist_sens(lat_hist_sens), m_is_attacker(is_attacker) {
   m_num_bubbles = inst.bubble_count;
   m_load_addr = inst.load_addr;
   m_writeback_addr = inst.store_addr;
+  m_load_translated = false;
+  m_writeback_translated = false;
   if (m_dump_path == "") {
     return;
   }
@@ -168,9 +170,14 @@ void BHO3Core::tick() {
     };
 
     Request load_request(m_load_addr, Request::Type::Read, m_id, m_callback);
-    if (m_translation && !m_translation->translate(load_request)) {
-      return;
-    };
+    if (m_translation && !m_load_translated) {
+      if (!m_translation->translate(load_request)) {
+        return;
+      };
+      // Keep the physical address so that a rejected send is retried without translating (and counting TLB accesses) again
+      m_load_addr = load_request.addr;
+      m_load_translated = true;
+    }
 
     if (m_llc->send(load_request)) {
       s_mem_requests_issued++;
@@ -190,9 +197,13 @@ void BHO3Core::tick() {
   // Third, try to send the writeback to the LLC
   if (m_writeback_addr != -1) {
     Request writeback_request(m_writeback_addr, Request::Type::Write, m_id, m_callback);
-    if (m_translation && !m_translation->translate(writeback_request)) {
-      return;
-    };
+    if (m_translation && !m_writeback_translated) {
+      if (!m_translation->translate(writeback_request)) {
+        return;
+      };
+      m_writeback_addr = writeback_request.addr;
+      m_writeback_translated = true;
+    }
     if (!m_llc->send(writeback_request)) {
       return;
     }
@@ -203,6 +214,8 @@ void BHO3Core::tick() {
   m_num_bubbles = inst.bubble_count;
   m_load_addr = inst.load_addr;
   m_writeback_addr = inst.store_addr;      
+  m_load_translated = false;
+  m_writeback_translated = false;
 }
 
 void BHO3Core::receive(Request& req) {
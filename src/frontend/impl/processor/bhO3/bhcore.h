@@ -95,6 +95,8 @@ class BHO3Core: public Clocked<BHO3Core> {
     int    m_num_bubbles = 0;
     Addr_t m_load_addr = -1;
     Addr_t m_writeback_addr = -1;
+    bool   m_load_translated = false;        // Whether m_load_addr is already translated (i.e., the send is being retried)
+    bool   m_writeback_translated = false;
 
     size_t m_num_expected_insts = 0;  
     uint64_t m_num_max_cycles = 0;
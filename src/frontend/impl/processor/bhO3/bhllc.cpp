@@ -27,35 +27,35 @@ m_latency(latency), m_size_bytes(size_bytes), m_linesize_bytes(linesize_bytes),
 void BHO3LLC::tick() {
   m_clk++;
 
-  // Send miss requests to the memory system when LLC latency is met
-  // TODO: Optimization by assuming in-order issue?
-  auto it = m_miss_list.begin(); 
-  while (it != m_miss_list.end()) {
-    if (m_clk >= it->first) {
-      if (!m_memory_system->send(it->second)) {
-        it++;
-      }
-      else {
-        it = m_miss_list.erase(it);
-      }
-    } else {
-      it++;
+  // Send miss requests to the memory system when LLC latency is met, retrying the ones rejected before first
+  if (!m_miss_retry_list.empty()) {
+    m_miss_retry_buffer.swap(m_miss_retry_list);
+    for (auto& req : m_miss_retry_buffer) {
+      send_miss(req);
     }
+    m_miss_retry_buffer.clear();
+  }
+  while (!m_miss_list.empty() && m_clk >= m_miss_list.front().first) {
+    Request req = std::move(m_miss_list.front().second);
+    m_miss_list.pop_front();
+    send_miss(req);
   }
 
   // call hit request callback when LLC latency is met
-  it = m_hit_list.begin();
-  while (it != m_hit_list.end()) {
-    if (m_clk >= it->first) {
-      std::vector<Request> _req_v{it->second};
-      m_receive_requests[it->second.addr] = _req_v;
-
-      it->second.callback(it->second);
-      it = m_hit_list.erase(it);
-    } 
-    else {
-      it++;
-    }
+  while (!m_hit_list.empty() && m_clk >= m_hit_list.front().first) {
+    Request req = std::move(m_hit_list.front().second);
+    m_hit_list.pop_front();
+
+    std::vector<Request> _req_v{req};
+    m_receive_requests[req.addr] = _req_v;
+
+    req.callback(req);
+  }
+}
+
+void BHO3LLC::send_miss(Request& req) {
+  if (!m_memory_system->send(req)) {
+    m_miss_retry_list.push_back(std::move(req));
   }
 }
 
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <list>
+#include <deque>
 #include <unordered_map>
 #include <iostream>
 #include <fstream>
@@ -42,12 +43,16 @@ class BHO3LLC : public Clocked<BHO3LLC> {
     std::unordered_map<Addr_t, std::vector<Request>> m_receive_requests;
 
     // Request that miss in the LLC with the clock cycle (current cycle + llc latency) that they 
-    // should be sent to the memory system
-    std::list<std::pair<Clk_t, Request>> m_miss_list;
+    // should be sent to the memory system. Since the latency is constant, the queue is in time order.
+    std::deque<std::pair<Clk_t, Request>> m_miss_list;
+
+    // Requests whose latency is met but that the memory system rejected, in the order to retry them
+    std::vector<Request> m_miss_retry_list;
+    std::vector<Request> m_miss_retry_buffer;   // Reused by tick() to swap with m_miss_retry_list
 
     // Request that hit in the LLC with the clock cycle (current cycle + llc latency) that they 
-    // should be sent back to the core (calls the callback)
-    std::list<std::pair<Clk_t, Request>> m_hit_list;
+    // should be sent back to the core (calls the callback). In time order like m_miss_list.
+    std::deque<std::pair<Clk_t, Request>> m_hit_list;
 
     IMemorySystem* m_memory_system;
 
@@ -127,6 +132,9 @@ class BHO3LLC : public Clocked<BHO3LLC> {
 
     CacheSet_t::iterator check_set_hit(CacheSet_t& set, Addr_t addr);
     MSHR_t::iterator check_mshr_hit(Addr_t addr);
+
+    void send_miss(Request& req);   // Sends a miss to the memory system, or queues it for retry if rejected
+
     std::unordered_set<uint32_t>& get_bank_blacklist(Request& req);
 };
 
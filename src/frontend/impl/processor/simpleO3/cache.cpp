@@ -0,0 +1,481 @@
+#include <iostream>
+#include "frontend/impl/processor/simpleO3/cache.h"
+
+namespace Ramulator {
+
+SimpleO3Cache::SimpleO3Cache(std::string name, int latency, int size_bytes, int linesize_bytes, int associativity, int num_mshrs, int writeback_buffer_size, bool inclusive):
+m_latency(latency), m_size_bytes(size_bytes), m_linesize_bytes(linesize_bytes), m_associativity(associativity), m_num_mshrs(num_mshrs),
+m_writeback_buffer_size(writeback_buffer_size), m_inclusive(inclusive) {
+  m_logger = Logging::create_logger("SimpleO3" + name);
+  m_receive_callback = [this](Request& req) { receive(req); };
+
+  m_set_size = m_size_bytes / (m_linesize_bytes * m_associativity);
+  m_index_mask = m_set_size - 1;
+  m_index_offset = calc_log2(m_linesize_bytes);
+  m_tag_offset = calc_log2(m_set_size) + m_index_offset;
+
+  DEBUG_LOG(DSIMPLEO3CACHE, m_logger, "Index mask: {0:x}", m_index_mask);
+  DEBUG_LOG(DSIMPLEO3CACHE, m_logger, "Index offset: {}",  m_index_offset);
+  DEBUG_LOG(DSIMPLEO3CACHE, m_logger, "Tag offset: {}",    m_tag_offset);
+};
+
+void SimpleO3Cache::tick() {
+  m_clk++;
+
+  // Send miss requests to the lower level when the latency is met, retrying the ones rejected before first
+  if (!m_miss_retry_list.empty()) {
+    m_miss_retry_buffer.swap(m_miss_retry_list);
+    for (auto& req : m_miss_retry_buffer) {
+      send_miss(req);
+    }
+    m_miss_retry_buffer.clear();
+  }
+  while (!m_miss_list.empty() && m_clk >= m_miss_list.front().first) {
+    Request req = std::move(m_miss_list.front().second);
+    m_miss_list.pop_front();
+    send_miss(req);
+  }
+
+  // call hit request callback when the latency is met
+  while (!m_hit_list.empty() && m_clk >= m_hit_list.front().first) {
+    Request req = std::move(m_hit_list.front().second);
+    m_hit_list.pop_front();
+    req.callback(req);
+  }
+};
+
+void SimpleO3Cache::send_miss(Request& req) {
+  // Misses are always reads, so the writes are the writebacks
+  bool is_writeback = (req.type_id == Request::Type::Write);
+
+  bool request_sent = false;
+  if (m_lower_level) {
+    request_sent = is_writeback ? m_lower_level->writeback(req) : m_lower_level->send(req);
+  } else {
+    request_sent = m_memory_system->send(req);
+  }
+  if (!request_sent) {
+    m_miss_retry_list.push_back(std::move(req));
+    return;
+  }
+
+  if (is_writeback) {
+    m_num_pending_writebacks--;
+  }
+  if (m_capture_file.is_open()) {
+    capture(req);
+  }
+};
+
+bool SimpleO3Cache::send(Request req) {
+  CacheSet_t& set = get_set(req.addr);
+
+  if (req.type_id == Request::Type::Read) {
+    s_read_access++;
+  } else if (req.type_id == Request::Type::Write) {
+    s_write_access++;
+  }
+
+  if (auto line_it = check_set_hit(set, req.addr); line_it != set.end()) {
+    // Hit in the set
+    DEBUG_LOG(DSIMPLEO3CACHE, m_logger, 
+    "[Clk={}] Request Source: {}, Type: {}, Addr: {}, Index: {}, Tag: {}. Hit, will finish at Clk={}", 
+    m_clk, req.source_id, req.type_id, req.addr, get_index(req.addr), get_tag(req.addr), m_clk, m_clk + m_latency
+    );
+
+    // Update the LRU status
+    set.push_back({req.addr, get_tag(req.addr), line_it->dirty || (req.type_id == Request::Type::Write), true});
+    set.erase(line_it);
+
+    // Add to the hit list to callback when finished
+    m_hit_list.push_back(std::make_pair(m_clk + m_latency, req));
+    return true;
+  } else {
+    // Miss in the set
+    DEBUG_LOG(DSIMPLEO3CACHE, m_logger, 
+    "[Clk={}] Request Source: {}, Type: {}, Addr: {}, Index: {}, Tag: {}. Miss.", 
+    m_clk, req.source_id, req.type_id, req.addr, get_index(req.addr), get_tag(req.addr), m_clk, m_clk + m_latency
+    );
+
+    if (req.type_id == Request::Type::Read) {
+      s_read_misses++;
+    } else if (req.type_id == Request::Type::Write) {
+      s_write_misses++;
+    }
+
+    bool dirty = (req.type_id == Request::Type::Write);
+    if (req.type_id == Request::Type::Write) {
+      req.type_id = Request::Type::Read;
+    }
+
+    // MSHR lookup
+    auto mshr_it = check_mshr_hit(req.addr);
+    if (mshr_it != m_mshrs.end()) {
+      DEBUG_LOG(DSIMPLEO3CACHE, m_logger,  "MSHR Hit.", m_clk);
+      if (dirty && !mark_dirty(mshr_it->second.line_it)) {
+        DEBUG_LOG(DSIMPLEO3CACHE, m_logger,  "Writeback buffer full.", m_clk);
+        return false;
+      }
+      // Add new req to the MSHR entry
+      mshr_it->second.requests.push_back(req);
+      return true;
+    }
+
+    // MSHR miss
+    // Check if there is available MSHR entry
+    if (m_mshrs.size() == (size_t) m_num_mshrs) {
+      DEBUG_LOG(DSIMPLEO3CACHE, m_logger,  "No MSHR entry available.", m_clk);
+      s_mshr_unavailable++;
+      return false;
+    }
+
+    // Check if there is available cache line in the set
+    bool line_available = false;
+    if (set.size() < m_associativity) {
+      line_available = true;
+    } else {
+      for (const auto& line : set) {
+        if (line.ready) {
+          line_available = true;
+        }
+      }
+    }
+    if (!line_available) {
+      DEBUG_LOG(DSIMPLEO3CACHE, m_logger,  "No cache line available in the set.", m_clk);
+      return false;
+    }
+
+    // Check if the writeback of the victim (including the dirty copies an inclusive level invalidates above) fits in the
+    // writeback buffer
+    if (m_writeback_buffer_size > 0 && m_num_pending_writebacks >= m_writeback_buffer_size && need_eviction(set, req.addr)) {
+      auto victim_it = get_victim(set);
+      bool victim_dirty = victim_it->dirty;
+      if (m_inclusive) {
+        for (auto upper_level : m_upper_levels) {
+          victim_dirty |= upper_level->is_dirty_on_invalidate(victim_it->addr);
+        }
+      }
+      if (victim_dirty) {
+        DEBUG_LOG(DSIMPLEO3CACHE, m_logger,  "Writeback buffer full.", m_clk);
+        s_writeback_buffer_full++;
+        return false;
+      }
+    }
+
+    // Allocate a new cache line
+    auto newline_it = allocate_line(set, req.addr);
+    if (newline_it == set.end()) {
+      throw std::runtime_error("Failed to allocate new line when there is available entry.");
+    }
+    newline_it->dirty = dirty;
+    
+    // Add to MSHR entries
+    m_mshrs[align(req.addr)] = {newline_it, {req}};
+
+    // Add to the miss request list. The lower level calls this level back when the line is filled.
+    Request miss_req = req;
+    miss_req.callback = m_receive_callback;
+    m_miss_list.push_back(std::make_pair(m_clk + m_latency, miss_req));
+
+    return true;
+  }
+};
+
+bool SimpleO3Cache::writeback(Request req) {
+  CacheSet_t& set = get_set(req.addr);
+  if (auto line_it = std::find_if(set.begin(), set.end(), [&req, this](Line l){return (l.tag == get_tag(req.addr));}); line_it != set.end()) {
+    if (!mark_dirty(line_it)) {
+      return false;
+    }
+    DEBUG_LOG(DSIMPLEO3CACHE, m_logger, "[Clk={}] Writeback {} absorbed.", m_clk, req.addr);
+    return true;
+  }
+
+  // The line is not in this level, pass it on to the lower level
+  if (m_writeback_buffer_size > 0 && m_num_pending_writebacks >= m_writeback_buffer_size) {
+    s_writeback_buffer_full++;
+    return false;
+  }
+  m_miss_list.push_back(std::make_pair(m_clk + m_latency, req));
+  m_num_pending_writebacks++;
+  return true;
+};
+
+void SimpleO3Cache::receive(Request& req) {
+  auto it = check_mshr_hit(req.addr);
+
+  DEBUG_LOG(DSIMPLEO3CACHE, m_logger, "[Clk={}] Request {} received.", m_clk, req.addr);
+
+  if (it == m_mshrs.end()) {
+    return;
+  }
+
+  it->second.line_it->ready = true;
+  if (it->second.capture_record >= 0 && req.source_id >= 0 && req.source_id < m_last_completed_read.size()) {
+    m_last_completed_read[req.source_id] = it->second.capture_record;
+  }
+
+  std::vector<Request> requests = std::move(it->second.requests);
+  auto line_it = it->second.line_it;
+  bool invalidate_on_fill = it->second.invalidate_on_fill;
+  m_mshrs.erase(it);
+  for (auto& r : requests) {
+    r.arrive = req.arrive;
+    r.depart = req.depart;
+    if (r.callback) {
+      r.callback(r);
+    }
+  }
+
+  // The lower level evicted the line while it was being filled here, so it cannot stay
+  if (invalidate_on_fill) {
+    DEBUG_LOG(DSIMPLEO3CACHE, m_logger, "[Clk={}] Line {} back-invalidated on fill.", m_clk, line_it->addr);
+    s_back_invalidations++;
+    if (line_it->dirty) {
+      // Its writeback buffer slot was reserved when the line was written (see mark_dirty)
+      Request writeback_req(line_it->addr, Request::Type::Write);
+      m_miss_list.push_back(std::make_pair(m_clk + m_latency, writeback_req));
+      s_writebacks++;
+    }
+    get_set(line_it->addr).erase(line_it);
+  }
+};
+
+bool SimpleO3Cache::invalidate(Addr_t addr) {
+  bool dirty = false;
+  for (auto upper_level : m_upper_levels) {
+    dirty |= upper_level->invalidate(addr);
+  }
+
+  CacheSet_t& set = get_set(addr);
+  auto line_it = std::find_if(set.begin(), set.end(), [addr, this](Line l){return (l.tag == get_tag(addr));});
+  if (line_it == set.end()) {
+    return dirty;
+  }
+  if (!line_it->ready) {
+    // The requests waiting for the line still need its data, so it is dropped when the fill arrives (see receive). The
+    // evicting level writes back its dirty data so far.
+    auto mshr_it = check_mshr_hit(addr);
+    if (!mshr_it->second.invalidate_on_fill) {
+      mshr_it->second.invalidate_on_fill = true;
+      dirty |= line_it->dirty;
+      line_it->dirty = false;
+    }
+    return dirty;
+  }
+  DEBUG_LOG(DSIMPLEO3CACHE, m_logger, "[Clk={}] Line {} back-invalidated.", m_clk, line_it->addr);
+  s_back_invalidations++;
+  dirty |= line_it->dirty;
+  set.erase(line_it);
+  return dirty;
+};
+
+bool SimpleO3Cache::is_dirty_on_invalidate(Addr_t addr) {
+  bool dirty = false;
+  for (auto upper_level : m_upper_levels) {
+    dirty |= upper_level->is_dirty_on_invalidate(addr);
+  }
+
+  CacheSet_t& set = get_set(addr);
+  auto line_it = std::find_if(set.begin(), set.end(), [addr, this](Line l){return (l.tag == get_tag(addr));});
+  if (line_it == set.end()) {
+    return dirty;
+  }
+  if (!line_it->ready && check_mshr_hit(addr)->second.invalidate_on_fill) {
+    // Already invalidated, the line writes itself back on fill
+    return dirty;
+  }
+  return dirty || line_it->dirty;
+};
+
+SimpleO3Cache::CacheSet_t& SimpleO3Cache::get_set(Addr_t addr) {
+  int set_index = get_index(addr);
+  if (m_cache_sets.find(set_index) == m_cache_sets.end()) {
+    m_cache_sets.insert(make_pair(set_index, std::list<Line>()));
+  }
+  return m_cache_sets[set_index];
+}
+
+SimpleO3Cache::CacheSet_t::iterator SimpleO3Cache::allocate_line(CacheSet_t& set, Addr_t addr) {
+  // Check if we need to evict any line
+  if (need_eviction(set, addr)) {
+    // Get a victim to evict
+    auto victim = get_victim(set);
+    if (victim == set.end())
+      return victim;  // doesn't exist a line that's already unlocked in each level
+    evict_line(set, victim);
+  }
+
+  // Allocate new cache line and return an iterator to it
+  set.push_back({addr, get_tag(addr)});
+  return --set.end();
+}
+
+bool SimpleO3Cache::need_eviction(const CacheSet_t& set, Addr_t addr) {
+  if (std::find_if(set.begin(), set.end(), 
+            [addr, this](Line l) { return (get_tag(addr) == l.tag); }) 
+      != set.end()) {
+    // Due to MSHR, the program can't reach here. Just for checking
+    throw std::runtime_error("Allocating a line that is already in the set.");
+  } 
+  else {
+    if (set.size() < m_associativity) {
+      return false;
+    } else {
+      return true;
+    }
+  }
+}
+
+SimpleO3Cache::CacheSet_t::iterator SimpleO3Cache::get_victim(CacheSet_t& set) {
+  // The least-recently-used line that is not inflight
+  return std::find_if(set.begin(), set.end(), [](const Line& line) { return line.ready; });
+}
+
+void SimpleO3Cache::evict_line(CacheSet_t& set, CacheSet_t::iterator victim_it) {
+  DEBUG_LOG(DSIMPLEO3CACHE, m_logger,  "Evicting {}.", victim_it->addr);
+  s_eviction++;
+
+  bool dirty = victim_it->dirty;
+  if (m_inclusive) {
+    for (auto upper_level : m_upper_levels) {
+      dirty |= upper_level->invalidate(victim_it->addr);
+    }
+  }
+
+  // Generate writeback request if victim line is dirty
+  if (dirty) {
+    Request writeback_req(victim_it->addr, Request::Type::Write);
+    m_miss_list.push_back(std::make_pair(m_clk + m_latency, writeback_req));
+    m_num_pending_writebacks++;
+    s_writebacks++;
+
+    DEBUG_LOG(DSIMPLEO3CACHE, m_logger,  "Writeback Request will be issued at Clk={}.", m_clk + m_latency);
+  }
+
+  set.erase(victim_it);
+}
+
+
+bool SimpleO3Cache::mark_dirty(CacheSet_t::iterator line_it) {
+  if (!line_it->dirty && !line_it->ready && check_mshr_hit(line_it->addr)->second.invalidate_on_fill) {
+    // The line is dropped (and written back) on fill, so its writeback needs a slot now
+    if (m_writeback_buffer_size > 0 && m_num_pending_writebacks >= m_writeback_buffer_size) {
+      s_writeback_buffer_full++;
+      return false;
+    }
+    m_num_pending_writebacks++;
+  }
+  line_it->dirty = true;
+  return true;
+}
+
+SimpleO3Cache::CacheSet_t::iterator SimpleO3Cache::check_set_hit(CacheSet_t& set, Addr_t addr) {
+  auto line_it = std::find_if(set.begin(), set.end(), [addr, this](Line l){return (l.tag == get_tag(addr));});
+  if (line_it == set.end() || !line_it->ready) {
+    return set.end();
+  } else {
+    return line_it;
+  }
+}
+
+SimpleO3Cache::MSHR_t::iterator SimpleO3Cache::check_mshr_hit(Addr_t addr) {
+  return m_mshrs.find(align(addr));
+}
+
+void SimpleO3Cache::start_capture(std::string capture_filename, int clock_ratio, int num_cores) {
+  m_capture_file.open(capture_filename, std::ios::out | std::ios::binary);
+  if (!m_capture_file.is_open()) {
+    throw ConfigurationError("Cannot open the LLC capture file {}!", capture_filename);
+  }
+
+  MissTraceHeader header;
+  header.clock_ratio = clock_ratio;
+  header.num_cores = num_cores;
+  m_capture_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  m_last_completed_read.assign(num_cores, -1);
+}
+
+void SimpleO3Cache::stop_capture() {
+  if (m_capture_file.is_open()) {
+    m_capture_file.close();
+    m_logger->info("Captured {} requests.", m_num_captured);
+  }
+}
+
+void SimpleO3Cache::capture(const Request& req) {
+  MissTraceRecord record;
+  record.cycle = m_clk;
+  record.addr = req.addr;
+  record.type_id = req.type_id;
+  record.source_id = req.source_id;
+  record.dep = -1;
+  if (req.source_id >= 0 && req.source_id < m_last_completed_read.size()) {
+    record.dep = m_last_completed_read[req.source_id];
+  }
+  m_capture_file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+
+  if (req.type_id == Request::Type::Read) {
+    if (auto mshr_it = check_mshr_hit(req.addr); mshr_it != m_mshrs.end()) {
+      mshr_it->second.capture_record = m_num_captured;
+    }
+  }
+  m_num_captured++;
+}
+
+void SimpleO3Cache::serialize(std::string serialization_filename) {
+  std::ofstream serialization_file;
+  serialization_file.open(serialization_filename, std::ios::out);
+
+  serialization_file << "index,addr,tag,dirty" << std::endl;
+  for (auto it1 = m_cache_sets.begin(); it1 != m_cache_sets.end(); it1++) {
+    for (auto it2 = it1->second.begin(); it2 != it1->second.end(); it2++) {
+      serialization_file << it1->first << "," << it2->addr << "," << it2->tag << "," << it2->dirty << std::endl;
+    }
+  }
+  serialization_file.close();
+}
+
+void SimpleO3Cache::deserialize(std::string serialization_filename) {
+  std::ifstream serialization_file;
+  serialization_file.open(serialization_filename, std::ios::out);
+
+  std::string file_line;
+  std::getline(serialization_file, file_line); // Skip the first line, which is the header
+  while (std::getline(serialization_file, file_line)) {
+    std::string index_str = file_line.substr(0, file_line.find(","));
+    file_line = file_line.substr(file_line.find(",") + 1);
+    std::string addr_str = file_line.substr(0, file_line.find(","));
+    file_line = file_line.substr(file_line.find(",") + 1);
+    std::string tag_str = file_line.substr(0, file_line.find(","));
+    file_line = file_line.substr(file_line.find(",") + 1);
+    std::string dirty_str = file_line.substr(0, file_line.find(","));
+    
+    int index = std::stoi(index_str);
+    Addr_t addr = std::stoll(addr_str);
+    Addr_t tag = std::stoll(tag_str);
+    bool dirty = std::stoi(dirty_str);
+    if(m_cache_sets.find(index) == m_cache_sets.end()){
+      m_cache_sets.insert({index, std::list<SimpleO3Cache::Line>()});
+    }
+    m_cache_sets[index].push_back({addr, tag, dirty, 1});
+  }
+  serialization_file.close();
+}
+
+void SimpleO3Cache::dump() {
+  /**
+   * @brief dumps the cache to the console
+   * 
+   */
+  std::cout << "Dumping " << m_logger->name() << std::endl;
+  std::cout << "index,addr,tag,dirty,ready" << std::endl;
+  for (auto it1 = m_cache_sets.begin(); it1 != m_cache_sets.end(); it1++) {
+    for (auto it2 = it1->second.begin(); it2 != it1->second.end(); it2++) {
+      std::cout << it1->first << "," << it2->addr << "," << it2->tag << "," << it2->dirty << "," << it2->ready << std::endl;
+    }
+  }
+}
+
+}        // namespace Ramulator
\ No newline at end of file
@@ -0,0 +1,186 @@
+#ifndef     RAMULATOR_FRONTEND_PROCESSOR_SIMPLEO3_CACHE_H
+#define     RAMULATOR_FRONTEND_PROCESSOR_SIMPLEO3_CACHE_H
+
+#include <vector>
+#include <list>
+#include <deque>
+#include <string>
+#include <functional>
+#include <unordered_map>
+#include <iostream>
+#include <fstream>
+
+#include "base/clocked.h"
+#include "base/debug.h"
+#include "base/type.h"
+#include "base/request.h"
+#include "memory_system/memory_system.h"
+#include "frontend/impl/memory_trace/miss_trace.h"
+
+namespace Ramulator {
+
+DECLARE_DEBUG_FLAG(DSIMPLEO3CACHE);
+// ENABLE_DEBUG_FLAG(DSIMPLEO3CACHE);
+
+/**
+ * @brief   A cache level of the SimpleO3 memory hierarchy (i.e., the private L1D and L2 of a core, or the shared LLC)
+ * @details
+ * Requests that hit are called back after the latency. Requests that miss allocate a line and an MSHR entry and are
+ * sent to the lower level (or the memory system, if there is none) after the latency. When the line is filled, all
+ * requests waiting in its MSHR entry are called back. Writes allocate the line and mark it dirty.
+ *
+ * Evicted dirty lines are written back to the lower level. A writeback occupies the writeback buffer until the lower
+ * level accepts it, and a miss that has to evict a dirty line while the buffer is full is rejected. Writebacks from the
+ * upper level mark the line dirty, or are passed on to the lower level if the line is not here.
+ *
+ * An inclusive level also invalidates the lines it evicts in all levels above it, and writes them back if any of the
+ * invalidated copies is dirty. A line still being filled in a level above is dropped as soon as its fill has served the
+ * requests waiting for it. Its dirty data so far is written back by the evicting level, and the first write to it after
+ * that reserves a writeback buffer slot for its writeback on fill (or is rejected if the buffer is full).
+ */
+class SimpleO3Cache : public Clocked<SimpleO3Cache> {
+  friend class SimpleO3;
+  struct Line {
+    Addr_t addr = -1;
+    Addr_t tag = -1;
+    bool dirty = false;
+    bool ready = false;   // Whether this line is ready (i.e., is still inflight?)
+  };
+
+  private:
+    using CacheSet_t = std::list<Line>;   // LRU queue for the set. The head of the list is the least-recently-used way.
+    std::unordered_map<int, CacheSet_t> m_cache_sets;
+
+    struct MSHREntry_t {
+      CacheSet_t::iterator line_it;     // The line being filled
+      std::vector<Request> requests;    // The requests waiting for the line, in arrival order
+      int64_t capture_record = -1;      // The record of the read of the line in the miss trace (if captured)
+      bool invalidate_on_fill = false;  // Whether the line was back-invalidated while being filled
+    };
+    using MSHR_t = std::unordered_map<Addr_t, MSHREntry_t>;   // Indexed by the line address
+    MSHR_t m_mshrs;
+
+    // Request that miss in the cache (or writebacks) with the clock cycle (current cycle + latency) that they
+    // should be sent to the lower level. Since the latency is constant, the queue is in time order.
+    std::deque<std::pair<Clk_t, Request>> m_miss_list;
+
+    // Requests whose latency is met but that the lower level rejected, in the order to retry them
+    std::vector<Request> m_miss_retry_list;
+    std::vector<Request> m_miss_retry_buffer;   // Reused by tick() to swap with m_miss_retry_list
+
+    // Request that hit in the cache with the clock cycle (current cycle + latency) that they
+    // should be sent back to the upper level (calls the callback). In time order like m_miss_list.
+    std::deque<std::pair<Clk_t, Request>> m_hit_list;
+
+    std::function<void(Request&)> m_receive_callback;   // The callback of the misses sent to the lower level
+
+    SimpleO3Cache* m_lower_level = nullptr;
+    IMemorySystem* m_memory_system = nullptr;
+    std::vector<SimpleO3Cache*> m_upper_levels;
+
+    int m_num_pending_writebacks = 0;   // The writebacks in the writeback buffer (i.e., not accepted by the lower level yet)
+
+    // Capture of the requests sent to the memory system (disabled if the file is not open)
+    std::ofstream m_capture_file;
+    int64_t m_num_captured = 0;
+    std::vector<int64_t> m_last_completed_read;               // The record of the last completed read of each core
+
+    Logger_t m_logger;
+
+
+  public:
+    int m_latency;
+
+    size_t m_size_bytes;
+    size_t m_linesize_bytes;
+    int m_associativity;
+    int m_set_size;
+    int m_num_mshrs;
+    int m_writeback_buffer_size;    // 0 for unbounded
+    bool m_inclusive;
+
+    Addr_t m_index_mask;
+    int m_index_offset;
+    int m_tag_offset;
+
+
+    int s_read_access = 0;
+    int s_write_access = 0;
+    int s_read_misses = 0;
+    int s_write_misses = 0;
+    int s_eviction = 0;
+    int s_mshr_unavailable = 0;
+    int s_writebacks = 0;
+    int s_writeback_buffer_full = 0;
+    int s_back_invalidations = 0;
+
+
+  public:
+    SimpleO3Cache(std::string name, int latency, int size_bytes, int linesize_bytes, int associativity, int num_mshrs, int writeback_buffer_size = 0, bool inclusive = false);
+    void connect_memory_system(IMemorySystem* memory_system) { m_memory_system = memory_system; };
+    void connect_lower_level(SimpleO3Cache* lower_level) { m_lower_level = lower_level; lower_level->m_upper_levels.push_back(this); };
+
+    void tick();
+    bool send(Request req);
+
+    /**
+     * @brief   Receives a dirty line evicted from the upper level
+     *
+     * @return  False if the line has to be passed on to the lower level but the writeback buffer is full
+     */
+    bool writeback(Request req);
+
+    /**
+     * @brief   Called when the lower level (or the memory system) fills a line. Calls back the requests waiting for it.
+     *
+     */
+    void receive(Request& req);
+
+    /**
+     * @brief   Invalidates the line of addr in this level and the levels above it
+     *
+     * @return  True if any of the invalidated copies was dirty
+     */
+    bool invalidate(Addr_t addr);
+
+    /**
+     * @brief   Returns what invalidate(addr) would return, without invalidating anything
+     *
+     */
+    bool is_dirty_on_invalidate(Addr_t addr);
+
+    void serialize(std::string serialization_filename);
+    void deserialize(std::string serialization_filename);
+    void dump();
+
+    /**
+     * @brief   Records every request sent to the memory system to a binary miss trace (see miss_trace.h)
+     *
+     */
+    void start_capture(std::string capture_filename, int clock_ratio, int num_cores);
+    void stop_capture();
+
+  private:
+    int get_index(Addr_t addr)  { return (addr >> m_index_offset) & m_index_mask; };
+    Addr_t get_tag(Addr_t addr) { return (addr >> m_tag_offset); };
+    Addr_t align(Addr_t addr)   { return (addr & ~(m_linesize_bytes-1l)); };
+
+    CacheSet_t& get_set(Addr_t addr);
+    CacheSet_t::iterator allocate_line(CacheSet_t& set, Addr_t addr);
+    bool need_eviction(const CacheSet_t& set, Addr_t addr);
+    CacheSet_t::iterator get_victim(CacheSet_t& set);
+    void evict_line(CacheSet_t& set, CacheSet_t::iterator victim_it);
+    bool mark_dirty(CacheSet_t::iterator line_it);   // Returns false if the line needs a writeback buffer slot but the buffer is full
+
+    CacheSet_t::iterator check_set_hit(CacheSet_t& set, Addr_t addr);
+    MSHR_t::iterator check_mshr_hit(Addr_t addr);
+
+    void send_miss(Request& req);   // Sends a miss (or a writeback) to the lower level, or queues it for retry if rejected
+
+    void capture(const Request& req);
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_FRONTEND_PROCESSOR_SIMPLEO3_CACHE_H
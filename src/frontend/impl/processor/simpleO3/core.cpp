@@ -7,7 +7,7 @@
 #include "base/exception.h"
 #include "base/utils.h"
 #include "frontend/impl/processor/simpleO3/core.h"
-#include "frontend/impl/processor/simpleO3/llc.h"
+#include "frontend/impl/processor/simpleO3/cache.h"
 
 namespace Ramulator {
 
@@ -58,7 +58,7 @@ const SimpleO3Core::Trace::Inst& SimpleO3Core::Trace::get_next_inst() {
 
 SimpleO3Core::InstWindow::InstWindow(int ipc, int depth):
 m_ipc(ipc), m_depth(depth),
-m_ready_list(depth, false), m_addr_list(depth, -1) {};
+m_ready_list(depth, false) {};
 
 bool SimpleO3Core::InstWindow::is_full() {
   return m_load == m_depth;
@@ -66,7 +66,9 @@ bool SimpleO3Core::InstWindow::is_full() {
 
 void SimpleO3Core::InstWindow::insert(bool ready, Addr_t addr) {
   m_ready_list.at(m_head_idx) = ready;
-  m_addr_list.at(m_head_idx) = addr;
+  if (!ready && addr != -1) {
+    m_waiting_slots[addr].push_back(m_head_idx);
+  }
 
   m_head_idx = (m_head_idx + 1) % m_depth;
   m_load++;
@@ -88,30 +90,33 @@ int SimpleO3Core::InstWindow::retire() {
 }
 
 void SimpleO3Core::InstWindow::set_ready(Addr_t addr) {
-  if (m_load == 0) return;
+  auto it = m_waiting_slots.find(addr);
+  if (it == m_waiting_slots.end()) return;
 
-  int index = m_tail_idx;
-  for (int i = 0; i < m_load; i++) {
-    if (m_addr_list[index] == addr) {
-      m_ready_list[index] = true;
-    }
-    index++;
-    if (index == m_depth) {
-      index = 0;
-    }
+  for (int index : it->second) {
+    m_ready_list[index] = true;
   }
+  m_waiting_slots.erase(it);
 }
 
-SimpleO3Core::SimpleO3Core(int id, int ipc, int depth, size_t num_expected_insts, std::string trace_path, ITranslation* translation, SimpleO3LLC* llc):
-m_id(id), m_window(ipc, depth), m_trace(trace_path), m_num_expected_insts(num_expected_insts), m_translation(translation), m_llc(llc) {
+SimpleO3Core::SimpleO3Core(int id, int ipc, int depth, size_t num_expected_insts, std::string trace_path, ITranslation* translation, SimpleO3Cache* cache):
+m_id(id), m_window(ipc, depth), m_trace(trace_path), m_num_expected_insts(num_expected_insts), m_translation(translation), m_cache(cache) {
   // Fetch the instructions and addresses for tick 0
   auto inst = m_trace.get_next_inst();
   m_num_bubbles = inst.bubble_count;
   m_load_addr = inst.load_addr;
   m_writeback_addr = inst.store_addr;
+  m_load_translated = false;
+  m_writeback_translated = false;
 }
 
 void SimpleO3Core::tick() {
+  if (tick_local()) {
+    tick_memory();
+  }
+}
+
+bool SimpleO3Core::tick_local() {
   m_clk++;
 
   s_insts_retired += m_window.retire();
@@ -126,31 +131,42 @@ void SimpleO3Core::tick() {
   int num_inserted_insts = 0;
   while (m_num_bubbles > 0) {
     if (num_inserted_insts == m_window.m_ipc) {
-      return;
+      return false;
     }
     if (m_window.is_full()) {
-      return;
+      return false;
     };
     m_window.insert(true, -1);
     num_inserted_insts++;
     m_num_bubbles--;
   }
 
-  // Second, try to send the load to the LLC
+  // The load also needs a slot in the window in this cycle
   if (m_load_addr != -1) {
     if (num_inserted_insts == m_window.m_ipc) {
-      return;
+      return false;
     }
     if (m_window.is_full()) {
-      return;
+      return false;
     };
+  }
+  return true;
+}
 
+void SimpleO3Core::tick_memory() {
+  // Second, try to send the load to the cache
+  if (m_load_addr != -1) {
     Request load_request(m_load_addr, Request::Type::Read, m_id, m_callback);
-    if (!m_translation->translate(load_request)) {
-      return;
-    };
+    if (!m_load_translated) {
+      if (!m_translation->translate(load_request)) {
+        return;
+      };
+      // Keep the physical address so that a rejected send is retried without translating (and counting TLB accesses) again
+      m_load_addr = load_request.addr;
+      m_load_translated = true;
+    }
 
-    if (m_llc->send(load_request)) {
+    if (m_cache->send(load_request)) {
       m_window.insert(false, load_request.addr);
       m_load_addr = -1;
       if (m_writeback_addr != -1) {
@@ -164,13 +180,17 @@ void SimpleO3Core::tick() {
     }
   }
 
-  // Third, try to send the writeback to the LLC
+  // Third, try to send the writeback to the cache
   if (m_writeback_addr != -1) {
     Request writeback_request(m_writeback_addr, Request::Type::Write, m_id, m_callback);
-    if (!m_translation->translate(writeback_request)) {
-      return;
-    };
-    if (!m_llc->send(writeback_request)) {
+    if (!m_writeback_translated) {
+      if (!m_translation->translate(writeback_request)) {
+        return;
+      };
+      m_writeback_addr = writeback_request.addr;
+      m_writeback_translated = true;
+    }
+    if (!m_cache->send(writeback_request)) {
       return;
     }
   }
@@ -179,6 +199,8 @@ void SimpleO3Core::tick() {
   m_num_bubbles = inst.bubble_count;
   m_load_addr = inst.load_addr;
   m_writeback_addr = inst.store_addr;      
+  m_load_translated = false;
+  m_writeback_translated = false;
 }
 
 void SimpleO3Core::receive(Request& req) {
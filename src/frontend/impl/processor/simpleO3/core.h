@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <functional>
 
 #include "base/type.h"
@@ -11,7 +12,7 @@
 
 namespace Ramulator {
 
-class SimpleO3LLC;
+class SimpleO3Cache;
 
 class SimpleO3Core : public Clocked<SimpleO3Core> {
   friend class SimpleO3;
@@ -48,7 +49,7 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
       int m_tail_idx = 0;     // Tail index. The instruction at the tail will be retired first.
 
       std::vector<bool>   m_ready_list;   // Bitvector to mark whether each instruction is ready to be retired.
-      std::vector<Addr_t> m_addr_list;    // Which address is each LD/ST instruction targeting? TODO: Perf. optimization with unordered map?
+      std::unordered_map<Addr_t, std::vector<int>> m_waiting_slots;  // The slots of the LD/ST instructions still waiting for each address.
 
     public:
       InstWindow(int ipc = 4, int depth = 128);      
@@ -72,8 +73,9 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
       int    retire();
 
       /**
-       * @brief   Set a memory instruction to ready. Called by the callback when a request is served by the memory
-       * 
+       * @brief   Set the memory instructions waiting for addr to ready. Called by the callback when a request is served by the memory
+       * @details
+       * Only the instructions that are not ready yet are indexed, so a slot leaves the index before it can retire.
        */
       void   set_ready(Addr_t addr);
   };
@@ -84,13 +86,15 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
     Trace m_trace;
     InstWindow m_window;
     ITranslation* m_translation;
-    SimpleO3LLC* m_llc;
+    SimpleO3Cache* m_cache;         // The first cache level of the core (i.e., the L1D, the L2, or the LLC)
 
     std::function<void(Request&)> m_callback;
 
     int    m_num_bubbles = 0;
     Addr_t m_load_addr = -1;
     Addr_t m_writeback_addr = -1;
+    bool   m_load_translated = false;        // Whether m_load_addr is already translated (i.e., the send is being retried)
+    bool   m_writeback_translated = false;
 
     size_t m_num_expected_insts = 0;  
     Clk_t m_last_mem_cycle = 0; // The last cycle that a memory request departs from mc
@@ -105,7 +109,7 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
     Clk_t  s_mem_access_cycles = 0; 
 
   public:
-    SimpleO3Core(int id, int ipc, int depth, size_t num_expected_insts, std::string trace_path, ITranslation* translation, SimpleO3LLC* llc);
+    SimpleO3Core(int id, int ipc, int depth, size_t num_expected_insts, std::string trace_path, ITranslation* translation, SimpleO3Cache* cache);
 
     /**
      * @brief   Ticks the core.
@@ -113,6 +117,21 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
      */
     void tick() override;
 
+    /**
+     * @brief   The first part of tick(): retires and issues the non-memory instructions. Only touches the core's own
+     *          state, so the cores can do it concurrently.
+     * 
+     * @return  True if the core should go on with tick_memory() in this cycle.
+     */
+    bool tick_local();
+
+    /**
+     * @brief   The second part of tick(): sends the load and the writeback through the translation to the cache and
+     *          fetches the next instruction.
+     * 
+     */
+    void tick_memory();
+
     /**
      * @brief   Called when a request is served by the memory.
      * 
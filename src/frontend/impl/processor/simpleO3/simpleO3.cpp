@@ -1,14 +1,34 @@
 #include <functional>
+#include <thread>
+#include <barrier>
+#include <memory>
 
 #include "base/utils.h"
 #include "frontend/frontend.h"
 #include "translation/translation.h"
 #include "frontend/impl/processor/simpleO3/core.h"
-#include "frontend/impl/processor/simpleO3/llc.h"
+#include "frontend/impl/processor/simpleO3/cache.h"
 
 
 namespace Ramulator {
 
+/**
+ * @brief    Simple timing model OoO processor frontend
+ * @details
+ * The cores share an LLC. If l1d_capacity and/or l2_capacity are set, each core also gets a private L1D and/or L2 in
+ * front of it (and the traces should not be filtered by the L1 and the L2). All levels are SimpleO3Caches with the
+ * same line size, and inclusion_policy applies to the L2 and the LLC. The page table walks of the translation go to
+ * the LLC.
+ *
+ * With num_threads > 1, the cores tick concurrently: in every cycle, the threads first do the core-local part of the
+ * cores' ticks (SimpleO3Core::tick_local) on disjoint ranges of cores, then the main thread sends the cores' loads and
+ * writebacks through the translation to their caches in core order (SimpleO3Core::tick_memory). Since the cores only
+ * interact through the translation and the shared LLC, this gives the same results as ticking the cores serially.
+ * A memory system may respond to a request within send(), i.e., while the cores are ticking. In both modes, the cores
+ * receive such responses after all of them have ticked, so that they see them in the same cycle either way. The threads
+ * synchronize twice per cycle, so the parallel mode only pays off when each thread has many cores, and num_threads is
+ * limited to the number of hardware threads.
+ */
 class SimpleO3 final : public IFrontEnd, public Implementation {
   RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, SimpleO3, "SimpleO3", "Simple timing model OoO processor frontend.")
 
@@ -17,12 +37,23 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
 
     int m_num_cores = -1;
     std::vector<SimpleO3Core*> m_cores;
-    SimpleO3LLC* m_llc;
+    SimpleO3Cache* m_llc;
+    std::vector<SimpleO3Cache*> m_l2_caches;     // Empty if there is no private L2
+    std::vector<SimpleO3Cache*> m_l1d_caches;    // Empty if there is no private L1D
 
     size_t m_num_expected_insts = 0;
 
     std::string serialization_filename;
 
+    int m_num_threads = 1;
+    std::vector<std::thread> m_workers;
+    std::unique_ptr<std::barrier<>> m_barrier;
+    bool m_stop_workers = false;
+    std::vector<char> m_issuing;          // Whether each core goes on with tick_memory() in the current cycle
+
+    bool m_ticking_cores = false;
+    std::vector<Request> m_deferred_responses;    // The responses to the cores received while they are ticking
+
 
   public:
     void init() override {
@@ -41,35 +72,106 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       int llc_associativity     = param<int>("llc_associativity").desc("LLC set associativity.").default_val(8);
       int llc_capacity_per_core = parse_capacity_str(param<std::string>("llc_capacity_per_core").desc("LLC capacity per core.").default_val("2MB"));
       int llc_num_mshr_per_core = param<int>("llc_num_mshr_per_core").desc("Number of LLC MSHR entries per core.").default_val(16);
+      int llc_writeback_buffer  = param<int>("llc_writeback_buffer").desc("Number of LLC writeback buffer entries (0 for unbounded).").default_val(0);
+
+      // Private cache params
+      std::string l1d_capacity_str = param<std::string>("l1d_capacity").desc("Private L1D capacity per core. No L1D if not set.").default_val("");
+      int l1d_latency           = param<int>("l1d_latency").desc("Latency of the L1D.").default_val(4);
+      int l1d_associativity     = param<int>("l1d_associativity").desc("L1D set associativity.").default_val(8);
+      int l1d_num_mshr          = param<int>("l1d_num_mshr").desc("Number of L1D MSHR entries.").default_val(16);
+      int l1d_writeback_buffer  = param<int>("l1d_writeback_buffer").desc("Number of L1D writeback buffer entries (0 for unbounded).").default_val(8);
+
+      std::string l2_capacity_str = param<std::string>("l2_capacity").desc("Private L2 capacity per core. No L2 if not set.").default_val("");
+      int l2_latency            = param<int>("l2_latency").desc("Latency of the L2.").default_val(14);
+      int l2_associativity      = param<int>("l2_associativity").desc("L2 set associativity.").default_val(8);
+      int l2_num_mshr           = param<int>("l2_num_mshr").desc("Number of L2 MSHR entries.").default_val(32);
+      int l2_writeback_buffer   = param<int>("l2_writeback_buffer").desc("Number of L2 writeback buffer entries (0 for unbounded).").default_val(16);
+
+      std::string inclusion_policy = param<std::string>("inclusion_policy").desc("Inclusion policy of the L2 and the LLC (non_inclusive or inclusive).").default_val("non_inclusive");
+
+      int l1d_capacity = parse_capacity_str(l1d_capacity_str);
+      if (!l1d_capacity_str.empty() && l1d_capacity == 0) {
+        throw ConfigurationError("[SimpleO3] Invalid L1D capacity {}!", l1d_capacity_str);
+      }
+      int l2_capacity = parse_capacity_str(l2_capacity_str);
+      if (!l2_capacity_str.empty() && l2_capacity == 0) {
+        throw ConfigurationError("[SimpleO3] Invalid L2 capacity {}!", l2_capacity_str);
+      }
+      bool inclusive = false;
+      if (inclusion_policy == "inclusive") {
+        inclusive = true;
+      } else if (inclusion_policy != "non_inclusive") {
+        throw ConfigurationError("[SimpleO3] Unknown inclusion policy {}!", inclusion_policy);
+      }
 
       // Simulation parameters
       m_num_expected_insts = param<int>("num_expected_insts").desc("Number of instructions that the frontend should execute.").required();
+      std::string llc_capture_path = param<std::string>("llc_capture_path").desc("If set, the requests sent to the memory system are captured to this file (see MissTrace).").default_val("");
+      m_num_threads = param<int>("num_threads").desc("Number of threads to tick the cores with.").default_val(1);
+      if (m_num_threads < 1) {
+        throw ConfigurationError("[SimpleO3] The number of threads ({}) must be positive!", m_num_threads);
+      }
+      m_num_threads = std::min(m_num_threads, m_num_cores);
 
       // Create address translation module
       m_translation = create_child_ifce<ITranslation>();
 
       // Create the LLC
-      m_llc = new SimpleO3LLC(llc_latency, llc_capacity_per_core * m_num_cores, llc_linesize_bytes, llc_associativity, llc_num_mshr_per_core * m_num_cores);
+      m_llc = new SimpleO3Cache("LLC", llc_latency, llc_capacity_per_core * m_num_cores, llc_linesize_bytes, llc_associativity, llc_num_mshr_per_core * m_num_cores, llc_writeback_buffer, inclusive);
       // m_llc->deserialize(serialization_filename);
       // m_llc->serialize(serialization_filename);
+      if (!llc_capture_path.empty()) {
+        m_llc->start_capture(llc_capture_path, m_clock_ratio, m_num_cores);
+      }
+
+      // The translation sends its own requests (e.g., page table walks) to the LLC
+      m_translation->connect_memory_port([this](Request& req) {
+        req.callback = [this](Request& req){this->receive(req);};
+        return m_llc->send(req);
+      });
 
       // Create the cores
       for (int id = 0; id < m_num_cores; id++) {
-        SimpleO3Core* core = new SimpleO3Core(id, ipc, depth, m_num_expected_insts, trace_list[id], m_translation, m_llc);
+        // Create the private caches of the core on top of the LLC
+        SimpleO3Cache* cache = m_llc;
+        if (l2_capacity > 0) {
+          SimpleO3Cache* l2 = new SimpleO3Cache(fmt::format("L2_{}", id), l2_latency, l2_capacity, llc_linesize_bytes, l2_associativity, l2_num_mshr, l2_writeback_buffer, inclusive);
+          l2->connect_lower_level(cache);
+          m_l2_caches.push_back(l2);
+          cache = l2;
+        }
+        if (l1d_capacity > 0) {
+          SimpleO3Cache* l1d = new SimpleO3Cache(fmt::format("L1D_{}", id), l1d_latency, l1d_capacity, llc_linesize_bytes, l1d_associativity, l1d_num_mshr, l1d_writeback_buffer);
+          l1d->connect_lower_level(cache);
+          m_l1d_caches.push_back(l1d);
+          cache = l1d;
+        }
+
+        SimpleO3Core* core = new SimpleO3Core(id, ipc, depth, m_num_expected_insts, trace_list[id], m_translation, cache);
         core->m_callback = [this](Request& req){return this->receive(req);} ;
         m_cores.push_back(core);
       }
 
       m_logger = Logging::create_logger("SimpleO3");
+      // More threads than hardware threads only add context switches to the synchronizations of every cycle
+      int num_hw_threads = std::thread::hardware_concurrency();
+      if (num_hw_threads > 0 && m_num_threads > num_hw_threads) {
+        m_logger->warn("Limiting the number of threads ({}) to the number of hardware threads ({}).", m_num_threads, num_hw_threads);
+        m_num_threads = num_hw_threads;
+      }
+      if (m_num_threads > 1) {
+        start_workers();
+      }
 
       // Register the stats
       register_stat(m_num_expected_insts).name("num_expected_insts");
-      register_stat(m_llc->s_llc_eviction).name("llc_eviction");
-      register_stat(m_llc->s_llc_read_access).name("llc_read_access");
-      register_stat(m_llc->s_llc_write_access).name("llc_write_access");
-      register_stat(m_llc->s_llc_read_misses).name("llc_read_misses");
-      register_stat(m_llc->s_llc_write_misses).name("llc_write_misses");
-      register_stat(m_llc->s_llc_mshr_unavailable).name("llc_mshr_unavailable");
+      register_cache_stats(m_llc, "llc", "");
+      for (int core_id = 0; core_id < m_l2_caches.size(); core_id++) {
+        register_cache_stats(m_l2_caches[core_id], "l2", fmt::format("_core_{}", core_id));
+      }
+      for (int core_id = 0; core_id < m_l1d_caches.size(); core_id++) {
+        register_cache_stats(m_l1d_caches[core_id], "l1d", fmt::format("_core_{}", core_id));
+      }
       
       for (int core_id = 0; core_id < m_cores.size(); core_id++) {
         // register_stat(m_cores[core_id]->s_insts_retired).name("cycles_retired_core_{}", core_id);
@@ -86,21 +188,49 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       }
 
       m_llc->tick();
-      for (auto core : m_cores) {
-        core->tick();
+      for (auto cache : m_l2_caches) {
+        cache->tick();
+      }
+      for (auto cache : m_l1d_caches) {
+        cache->tick();
+      }
+      m_translation->tick();
+
+      m_ticking_cores = true;
+      if (m_num_threads == 1) {
+        for (auto core : m_cores) {
+          core->tick();
+        }
+      } else {
+        m_barrier->arrive_and_wait();     // Start the workers
+        tick_cores_local(0);
+        m_barrier->arrive_and_wait();     // Wait for the workers
+        for (int id = 0; id < m_num_cores; id++) {
+          if (m_issuing[id]) {
+            m_cores[id]->tick_memory();
+          }
+        }
+      }
+      m_ticking_cores = false;
+
+      for (auto& req : m_deferred_responses) {
+        m_cores[req.source_id]->receive(req);
       }
+      m_deferred_responses.clear();
     }
 
     void receive(Request& req) {
-      m_llc->receive(req);
-
+      // Called back by the caches when the request of a core (or the translation) is served
       // TODO: LLC latency for the core to receive the request?
-      for (auto r : m_llc->m_receive_requests[req.addr]) {
-        r.arrive = req.arrive;
-        r.depart = req.depart;
-        m_cores[r.source_id]->receive(r);
+      if (!m_translation->receive(req)) {
+        if (m_ticking_cores) {
+          // Otherwise, in the parallel mode, a core would see the response one cycle later than in the serial mode if it
+          // has already done its tick_local()
+          m_deferred_responses.push_back(req);
+        } else {
+          m_cores[req.source_id]->receive(req);
+        }
       }
-      m_llc->m_receive_requests[req.addr].clear();
     };
 
     bool is_finished() override {
@@ -112,13 +242,75 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       return true;
     }
 
+    ~SimpleO3() {
+      stop_workers();
+    };
+
+    void finalize() override {
+      stop_workers();
+      m_llc->stop_capture();
+      IFrontEnd::finalize();
+    };
+
     void connect_memory_system(IMemorySystem* memory_system) override {
       m_llc->connect_memory_system(memory_system);
+      // Set up the components (e.g., the translation)
+      IFrontEnd::connect_memory_system(memory_system);
     };
 
     int get_num_cores() override {
       return m_num_cores;
     };
+
+  private:
+    void register_cache_stats(SimpleO3Cache* cache, std::string prefix, std::string suffix) {
+      register_stat(cache->s_eviction).name("{}_eviction{}", prefix, suffix);
+      register_stat(cache->s_read_access).name("{}_read_access{}", prefix, suffix);
+      register_stat(cache->s_write_access).name("{}_write_access{}", prefix, suffix);
+      register_stat(cache->s_read_misses).name("{}_read_misses{}", prefix, suffix);
+      register_stat(cache->s_write_misses).name("{}_write_misses{}", prefix, suffix);
+      register_stat(cache->s_mshr_unavailable).name("{}_mshr_unavailable{}", prefix, suffix);
+      register_stat(cache->s_writebacks).name("{}_writebacks{}", prefix, suffix);
+      register_stat(cache->s_writeback_buffer_full).name("{}_writeback_buffer_full{}", prefix, suffix);
+      register_stat(cache->s_back_invalidations).name("{}_back_invalidations{}", prefix, suffix);
+    };
+
+    void tick_cores_local(int thread_id) {
+      int begin = m_num_cores * thread_id / m_num_threads;
+      int end = m_num_cores * (thread_id + 1) / m_num_threads;
+      for (int id = begin; id < end; id++) {
+        m_issuing[id] = m_cores[id]->tick_local();
+      }
+    };
+
+    void start_workers() {
+      m_issuing.resize(m_num_cores, false);
+      m_barrier = std::make_unique<std::barrier<>>(m_num_threads);
+      for (int thread_id = 1; thread_id < m_num_threads; thread_id++) {
+        m_workers.emplace_back([this, thread_id]() {
+          while (true) {
+            m_barrier->arrive_and_wait();
+            if (m_stop_workers) {
+              return;
+            }
+            tick_cores_local(thread_id);
+            m_barrier->arrive_and_wait();
+          }
+        });
+      }
+    };
+
+    void stop_workers() {
+      if (m_workers.empty()) {
+        return;
+      }
+      m_stop_workers = true;
+      m_barrier->arrive_and_wait();
+      for (auto& worker : m_workers) {
+        worker.join();
+      }
+      m_workers.clear();
+    };
 };
 
 }        // namespace Ramulator
\ No newline at end of file
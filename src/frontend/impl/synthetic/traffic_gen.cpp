@@ -0,0 +1,336 @@
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <limits>
+
+#include "frontend/frontend.h"
+#include "base/exception.h"
+#include "base/utils.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Generates synthetic memory traffic to measure loaded latency (i.e., latency vs. bandwidth curves).
+ * @details
+ * A list of patterns run concurrently, each as its own source (source_id = index in the list):
+ *
+ *   patterns:
+ *     - name: bw                 # Defaults to pattern<index>
+ *       type: stream             # stream, strided, random, or pointer_chase
+ *       base: 0                  # The accessed range [base, base + size)
+ *       size: 256MB
+ *       stride: 64               # strided only
+ *       read_ratio: 0.8          # The fraction of reads (the rest are writes)
+ *       max_outstanding: 32      # Max number of reads in flight
+ *       rate_scale: 1.0          # The pattern injects rate_scale times the current injection rate
+ *     - name: lat
+ *       type: pointer_chase      # Dependent reads: the next read is sent when the previous one returns
+ *
+ * The run sweeps the injection rates (requests per frontend cycle and pattern) in injection_rates, cycles_per_rate
+ * cycles each. Requests issued during the first warmup_cycles of a rate are not recorded. Pointer chasing ignores the
+ * injection rate: each line of its range holds the address of the next line to read, and the lines form a single
+ * random cycle, so every address depends on the previous one and the whole range is visited before any line repeats.
+ * Reads are tracked through their callbacks, and writes are posted. The latency histogram is kept per injection rate.
+ */
+class TrafficGen : public IFrontEnd, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, TrafficGen, "TrafficGen", "Synthetic traffic generator sweeping injection rates.")
+
+  private:
+    enum class PatternType { Stream, Strided, Random, PointerChase };
+
+    struct Pattern {
+      std::string name;
+      PatternType type;
+      Addr_t base;
+      Addr_t size;
+      Addr_t stride;
+      float read_ratio;
+      int max_outstanding;
+      float rate_scale;
+
+      Addr_t offset = 0;          // The offset of the next stream/strided/pointer chase access
+      std::vector<uint32_t> next_line;  // Pointer chase only: the line pointed to by each line of the range
+      double credit = 0;          // The number of requests that can be injected
+      int num_outstanding = 0;
+
+      Addr_t next_addr = -1;      // The next request (-1 if not generated yet)
+      bool next_is_write = false;
+
+      // Per injection rate
+      std::vector<size_t> s_num_reads;
+      std::vector<size_t> s_num_writes;
+      std::vector<size_t> s_read_latency;
+      std::vector<size_t> s_num_recorded_reads;
+      std::vector<float> s_achieved_rate;
+      std::vector<float> s_avg_read_latency;
+      std::vector<std::vector<size_t>> s_read_latency_histogram;
+    };
+    std::vector<Pattern> m_patterns;
+
+    std::vector<float> m_injection_rates;
+    Clk_t m_cycles_per_rate;
+    Clk_t m_warmup_cycles;
+    int m_num_steps;
+
+    Addr_t m_linesize;
+    int m_histogram_bin_width;
+    int m_histogram_num_bins;
+
+    std::mt19937_64 m_rng;
+
+    Logger_t m_logger;
+
+  public:
+    void init() override {
+      m_clock_ratio = param<uint>("clock_ratio").required();
+      m_injection_rates = param<std::vector<float>>("injection_rates").desc("The injection rates (requests per cycle and pattern) to sweep.").required();
+      m_cycles_per_rate = param<Clk_t>("cycles_per_rate").desc("Number of frontend cycles to run each injection rate for.").default_val(100000);
+      m_warmup_cycles = param<Clk_t>("warmup_cycles").desc("Number of cycles at the start of each injection rate that are not recorded.").default_val(10000);
+      m_linesize = param<Addr_t>("linesize").desc("Request granularity in bytes.").default_val(64);
+      m_histogram_bin_width = param<int>("histogram_bin_width").desc("Width of a latency histogram bin in frontend cycles.").default_val(10);
+      m_histogram_num_bins = param<int>("histogram_num_bins").desc("Number of latency histogram bins (the last one collects the rest).").default_val(100);
+      int seed = param<int>("seed").desc("The seed for the random number generator.").default_val(123);
+      m_rng.seed(seed);
+
+      m_num_steps = m_injection_rates.size();
+      if (m_num_steps == 0) {
+        throw ConfigurationError("[TrafficGen] Please specify at least one injection rate!");
+      }
+      if (m_warmup_cycles >= m_cycles_per_rate) {
+        throw ConfigurationError("[TrafficGen] The warmup ({} cycles) must be shorter than an injection rate ({} cycles)!", m_warmup_cycles, m_cycles_per_rate);
+      }
+      if (m_histogram_bin_width <= 0 || m_histogram_num_bins <= 0) {
+        throw ConfigurationError("[TrafficGen] The latency histogram needs a positive bin width and number of bins!");
+      }
+
+      init_patterns();
+
+      m_logger = Logging::create_logger("TrafficGen");
+      m_logger->info("Sweeping {} injection rates with {} patterns.", m_num_steps, m_patterns.size());
+
+      register_stat(m_injection_rates).name("injection_rates");
+      for (auto& p : m_patterns) {
+        register_stat(p.s_num_reads).name("{}_num_reads", p.name);
+        register_stat(p.s_num_writes).name("{}_num_writes", p.name);
+        register_stat(p.s_achieved_rate).name("{}_achieved_rate", p.name);
+        register_stat(p.s_avg_read_latency).name("{}_avg_read_latency", p.name);
+        for (int step = 0; step < m_num_steps; step++) {
+          register_stat(p.s_read_latency_histogram[step]).name("{}_read_latency_histogram_{}", p.name, step);
+        }
+      }
+    };
+
+    void tick() override {
+      m_clk++;
+
+      int step = (m_clk - 1) / m_cycles_per_rate;
+      if (step >= m_num_steps) {
+        // Wait for the outstanding reads
+        return;
+      }
+      bool record = (m_clk - 1) % m_cycles_per_rate >= m_warmup_cycles;
+
+      for (int source_id = 0; source_id < m_patterns.size(); source_id++) {
+        Pattern& p = m_patterns[source_id];
+
+        if (p.type == PatternType::PointerChase) {
+          if (p.num_outstanding == 0) {
+            send(source_id, step, record);
+          }
+          continue;
+        }
+
+        float rate = m_injection_rates[step] * p.rate_scale;
+        // Keep at most one request's worth of credit that could not be used
+        p.credit = std::min(p.credit + rate, (double) rate + 1);
+        while (p.credit >= 1) {
+          if (!send(source_id, step, record)) {
+            break;
+          }
+          p.credit -= 1;
+        }
+      }
+    };
+
+    void finalize() override {
+      double recorded_cycles = m_cycles_per_rate - m_warmup_cycles;
+      for (auto& p : m_patterns) {
+        for (int step = 0; step < m_num_steps; step++) {
+          p.s_achieved_rate[step] = (p.s_num_reads[step] + p.s_num_writes[step]) / recorded_cycles;
+          p.s_avg_read_latency[step] = p.s_num_recorded_reads[step] ? (float) p.s_read_latency[step] / p.s_num_recorded_reads[step] : 0;
+        }
+      }
+
+      IFrontEnd::finalize();
+    };
+
+    int get_num_cores() override {
+      return m_patterns.size();
+    };
+
+  private:
+    void init_patterns() {
+      YAML::Node patterns = m_config["patterns"];
+      if (!patterns.IsSequence() || patterns.size() == 0) {
+        throw ConfigurationError("[TrafficGen] Please specify the traffic patterns in \"patterns\"!");
+      }
+
+      for (const auto& pattern : patterns) {
+        Pattern& p = m_patterns.emplace_back();
+        p.name = pattern["name"].as<std::string>(fmt::format("pattern{}", m_patterns.size() - 1));
+
+        std::string type = pattern["type"].as<std::string>("stream");
+        if (type == "stream") {
+          p.type = PatternType::Stream;
+        } else if (type == "strided") {
+          p.type = PatternType::Strided;
+        } else if (type == "random") {
+          p.type = PatternType::Random;
+        } else if (type == "pointer_chase") {
+          p.type = PatternType::PointerChase;
+        } else {
+          throw ConfigurationError("[TrafficGen] Unknown type {} of pattern {}!", type, p.name);
+        }
+
+        p.base = pattern["base"].as<Addr_t>(0);
+        p.size = parse_capacity_str(pattern["size"].as<std::string>("256MB"));
+        p.stride = p.type == PatternType::Strided ? pattern["stride"].as<Addr_t>(m_linesize) : m_linesize;
+        p.read_ratio = p.type == PatternType::PointerChase ? 1.0f : pattern["read_ratio"].as<float>(1.0f);
+        p.max_outstanding = p.type == PatternType::PointerChase ? 1 : pattern["max_outstanding"].as<int>(32);
+        p.rate_scale = pattern["rate_scale"].as<float>(1.0f);
+
+        if (p.size < m_linesize) {
+          throw ConfigurationError("[TrafficGen] The size ({} B) of pattern {} must be at least a line ({} B)!", p.size, p.name, m_linesize);
+        }
+        if (p.stride <= 0) {
+          throw ConfigurationError("[TrafficGen] The stride of pattern {} must be positive!", p.name);
+        }
+        if (p.read_ratio < 0.0f || p.read_ratio > 1.0f) {
+          throw ConfigurationError("[TrafficGen] The read ratio of pattern {} must be in [0, 1]!", p.name);
+        }
+        if (p.max_outstanding <= 0) {
+          throw ConfigurationError("[TrafficGen] Pattern {} must allow at least one outstanding read!", p.name);
+        }
+
+        p.s_num_reads.resize(m_num_steps, 0);
+        p.s_num_writes.resize(m_num_steps, 0);
+        p.s_read_latency.resize(m_num_steps, 0);
+        p.s_num_recorded_reads.resize(m_num_steps, 0);
+        p.s_achieved_rate.resize(m_num_steps, 0);
+        p.s_avg_read_latency.resize(m_num_steps, 0);
+        p.s_read_latency_histogram.resize(m_num_steps, std::vector<size_t>(m_histogram_num_bins, 0));
+
+        if (p.type == PatternType::PointerChase) {
+          init_chain(p);
+        }
+      }
+    };
+
+    /**
+     * @brief    Links the lines of a pointer chase pattern, in a random order, into a single cycle
+     */
+    void init_chain(Pattern& p) {
+      Addr_t num_lines = p.size / m_linesize;
+      if (num_lines > std::numeric_limits<uint32_t>::max()) {
+        throw ConfigurationError("[TrafficGen] Pattern {} has more than 2^32 lines to chase!", p.name);
+      }
+      std::vector<uint32_t> order(num_lines);
+      for (Addr_t i = 0; i < num_lines; i++) {
+        order[i] = i;
+      }
+      for (Addr_t i = num_lines - 1; i > 0; i--) {
+        std::swap(order[i], order[m_rng() % (i + 1)]);
+      }
+      p.next_line.resize(num_lines);
+      for (Addr_t i = 0; i < num_lines; i++) {
+        p.next_line[order[i]] = order[(i + 1) % num_lines];
+      }
+    };
+
+    void generate(Pattern& p) {
+      switch (p.type) {
+        case PatternType::Stream:
+        case PatternType::Strided: {
+          p.next_addr = p.base + p.offset;
+          p.offset = (p.offset + p.stride) % p.size;
+          break;
+        }
+        case PatternType::Random: {
+          p.next_addr = p.base + (m_rng() % (p.size / m_linesize)) * m_linesize;
+          break;
+        }
+        case PatternType::PointerChase: {
+          // Follow the pointer in the line read last
+          p.next_addr = p.base + p.offset;
+          p.offset = (Addr_t) p.next_line[p.offset / m_linesize] * m_linesize;
+          break;
+        }
+      }
+      p.next_is_write = std::uniform_real_distribution<float>(0.0f, 1.0f)(m_rng) >= p.read_ratio;
+    };
+
+    /**
+     * @brief    Tries to send the next request of the pattern, returns false if it cannot be sent in this cycle
+     */
+    bool send(int source_id, int step, bool record) {
+      Pattern& p = m_patterns[source_id];
+      if (p.next_addr == -1) {
+        generate(p);
+      }
+
+      bool request_sent = false;
+      if (p.next_is_write) {
+        request_sent = m_memory_system->send({p.next_addr, Request::Type::Write, source_id, nullptr});
+      } else {
+        if (p.num_outstanding >= p.max_outstanding) {
+          return false;
+        }
+        request_sent = m_memory_system->send({p.next_addr, Request::Type::Read, source_id,
+          [this, source_id, step, record, issue_clk = m_clk](Request& req) {
+            receive(source_id, step, record, issue_clk);
+          }
+        });
+      }
+      if (!request_sent) {
+        return false;
+      }
+
+      if (p.next_is_write) {
+        p.s_num_writes[step] += record;
+      } else {
+        p.s_num_reads[step] += record;
+        p.num_outstanding++;
+      }
+      p.next_addr = -1;
+      return true;
+    };
+
+    void receive(int source_id, int step, bool record, Clk_t issue_clk) {
+      Pattern& p = m_patterns[source_id];
+      p.num_outstanding--;
+      if (!record) {
+        return;
+      }
+
+      Clk_t latency = m_clk - issue_clk;
+      p.s_read_latency[step] += latency;
+      p.s_num_recorded_reads[step]++;
+      int bin = std::min<Clk_t>(latency / m_histogram_bin_width, m_histogram_num_bins - 1);
+      p.s_read_latency_histogram[step][bin]++;
+    };
+
+    bool is_finished() override {
+      if (m_clk < m_num_steps * m_cycles_per_rate) {
+        return false;
+      }
+      for (const auto& p : m_patterns) {
+        if (p.num_outstanding > 0) {
+          return false;
+        }
+      }
+      return true;
+    };
+};
+
+}        // namespace Ramulator
@@ -0,0 +1,324 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <barrier>
+#include <algorithm>
+#include <cmath>
+
+#include <argparse/argparse.hpp>
+#include <spdlog/spdlog.h>
+
+#include "base/base.h"
+#include "base/config.h"
+#include "dram/dram.h"
+#include "addr_mapper/addr_mapper.h"
+#include "memory_system/memory_system.h"
+
+namespace Ramulator {
+
+struct TraceEntry {
+  Addr_t addr;
+  int type_id;
+};
+
+/**
+ * @brief    A memory system with only the device and the address mapper, so that an address mapper can be set up
+ *           (e.g., to query the organization of the device) without instantiating the controllers.
+ */
+class MapSearchSystem final : public IMemorySystem, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IMemorySystem, MapSearchSystem, "MapSearch", "Device and address mapper for offline address mapping exploration.");
+
+  public:
+    IDRAM* m_dram = nullptr;
+    IAddrMapper* m_addr_mapper = nullptr;
+
+  public:
+    void init() override {
+      m_dram = create_child_ifce<IDRAM>();
+      m_addr_mapper = create_child_ifce<IAddrMapper>();
+    };
+
+    bool send(Request req) override { return false; };
+
+    void tick() override { };
+};
+
+/**
+ * @brief    Maps every address of the trace with one candidate mapping and estimates how well it spreads them.
+ * @details
+ * Row-buffer locality is estimated with an open-row policy without timing: an access hits if its bank still has the
+ * same row open from the previous access to the bank, misses if the bank has no open row, and conflicts otherwise.
+ */
+struct Candidate {
+  std::string name;
+  MapSearchSystem* system = nullptr;
+  IAddrMapper* mapper = nullptr;
+
+  int bank_level = -1;
+  int row_level = -1;
+  std::vector<int> bank_strides;         // Stride of each level (up to the bank) in the flattened bank index
+
+  std::vector<size_t> channel_accesses;
+  std::vector<size_t> bank_accesses;
+  std::vector<int> open_rows;            // Currently open row of each bank (-1 if none)
+  size_t num_accesses = 0;
+  size_t row_hits = 0;
+  size_t row_misses = 0;
+  size_t row_conflicts = 0;
+
+  void setup() {
+    IDRAM* dram = system->m_dram;
+    bank_level = dram->m_levels("bank");
+    row_level = dram->m_levels("row");
+
+    int num_banks = 1;
+    bank_strides.resize(bank_level + 1, 0);
+    for (int level = bank_level; level >= 0; level--) {
+      bank_strides[level] = num_banks;
+      num_banks *= dram->m_organization.count[level];
+    }
+    channel_accesses.resize(dram->m_organization.count[0], 0);
+    bank_accesses.resize(num_banks, 0);
+    open_rows.resize(num_banks, -1);
+  };
+
+  void process(const std::vector<TraceEntry>& batch) {
+    Request req(0, Request::Type::Read);
+    for (const auto& entry : batch) {
+      req.addr = entry.addr;
+      req.type_id = entry.type_id;
+      mapper->apply(req);
+
+      int bank_id = 0;
+      for (int level = 0; level <= bank_level; level++) {
+        bank_id += req.addr_vec[level] * bank_strides[level];
+      }
+      int row = req.addr_vec[row_level];
+
+      channel_accesses[req.addr_vec[0]]++;
+      bank_accesses[bank_id]++;
+      if (open_rows[bank_id] == row) {
+        row_hits++;
+      } else if (open_rows[bank_id] == -1) {
+        row_misses++;
+      } else {
+        row_conflicts++;
+      }
+      open_rows[bank_id] = row;
+    }
+    num_accesses += batch.size();
+  };
+};
+
+/**
+ * @brief    Returns the max-to-mean ratio and the coefficient of variation of the access counts
+ */
+std::pair<double, double> balance(const std::vector<size_t>& counts) {
+  double sum = 0, max = 0;
+  for (auto count : counts) {
+    sum += count;
+    max = std::max(max, (double) count);
+  }
+  double mean = sum / counts.size();
+  if (mean == 0) {
+    return {0, 0};
+  }
+  double var = 0;
+  for (auto count : counts) {
+    var += (count - mean) * (count - mean);
+  }
+  return {max / mean, std::sqrt(var / counts.size()) / mean};
+};
+
+/**
+ * @brief    Reads up to batch_size requests from a load/store trace ("LD 0x1234" or "ST 0x1234" per line)
+ */
+void read_batch(std::ifstream& trace, size_t batch_size, std::vector<TraceEntry>& batch) {
+  batch.clear();
+  std::string line;
+  std::vector<std::string> tokens;
+  while (batch.size() < batch_size && std::getline(trace, line)) {
+    tokens.clear();
+    tokenize(tokens, line, " ");
+    if (tokens.size() < 2) {
+      continue;
+    }
+
+    int type;
+    if (tokens[0] == "LD") {
+      type = Request::Type::Read;
+    } else if (tokens[0] == "ST") {
+      type = Request::Type::Write;
+    } else {
+      throw ConfigurationError("Trace format invalid: {}", line);
+    }
+
+    Addr_t addr;
+    if (tokens[1].compare(0, 2, "0x") == 0 || tokens[1].compare(0, 2, "0X") == 0) {
+      addr = std::stoll(tokens[1].substr(2), nullptr, 16);
+    } else {
+      addr = std::stoll(tokens[1]);
+    }
+    batch.push_back({addr, type});
+  }
+};
+
+}        // namespace Ramulator
+
+
+/**
+ * @brief    Streams a load/store trace once through many candidate address mappers and reports, per candidate, the
+ *           channel/bank balance and the estimated row-buffer locality.
+ * @details
+ * The configuration file gives the DRAM as in a simulation config, and the candidates as address mapper configs:
+ *
+ *   MemorySystem:
+ *     DRAM: { impl: DDR4, org: { preset: DDR4_8Gb_x8, channel: 1, rank: 2 }, timing: { preset: DDR4_2400R } }
+ *   MapSearch:
+ *     trace: ./random_5M_R8W2_ramulatorv2.trace   # LD/ST trace, e.g., from perf_comparison/traces/gen_all_traces.sh
+ *     threads: 4            # Worker threads, each mapping the trace with a subset of the candidates
+ *     batch_size: 65536     # Number of requests read (and mapped by every candidate) at a time
+ *     candidates:
+ *       - impl: RoBaRaCoCh
+ *       - name: bank_xor
+ *         impl: Bitmask
+ *         mapping: { ... }
+ *
+ * The results are printed as YAML.
+ */
+int main(int argc, char* argv[]) {
+  using namespace Ramulator;
+
+  argparse::ArgumentParser program("ramulator_mapsearch", "2.0");
+  program.add_argument("-f", "--config_file").metavar("path-to-configuration-file")
+    .help("Path to a YAML configuration file with the DRAM (MemorySystem) and the candidate mappings (MapSearch).");
+  program.add_argument("-p", "--param").metavar("KEY=VALUE")
+    .append()
+    .help("Specify parameter to override in the configuration file. Repeat this option to change multiple parameters.");
+
+  try {
+    program.parse_args(argc, argv);
+  }
+  catch (const std::runtime_error& err) {
+    spdlog::error(err.what());
+    std::cerr << program;
+    std::exit(1);
+  }
+
+  std::string config_file_path;
+  if (auto arg = program.present<std::string>("-f")) {
+    config_file_path = *arg;
+  } else {
+    spdlog::error("No configuration file specified!");
+    std::cerr << program;
+    std::exit(1);
+  }
+
+  std::vector<std::string> params;
+  if (auto arg = program.present<std::vector<std::string>>("-p")) {
+    params = *arg;
+  }
+  YAML::Node config = Config::parse_config_file(config_file_path, params);
+
+  YAML::Node search_config = config["MapSearch"];
+  if (!search_config || !search_config["candidates"] || !search_config["trace"]) {
+    spdlog::error("Please specify the trace and the candidate address mappers in MapSearch!");
+    std::exit(1);
+  }
+  std::string trace_path = search_config["trace"].as<std::string>();
+  size_t batch_size = search_config["batch_size"].as<size_t>(65536);
+  int num_threads = search_config["threads"].as<int>(std::thread::hardware_concurrency());
+
+  // Instantiate the device and one address mapper per candidate
+  std::vector<Candidate> candidates;
+  for (const auto& candidate_config : search_config["candidates"]) {
+    YAML::Node system_config;
+    system_config["MemorySystem"]["impl"] = "MapSearch";
+    system_config["MemorySystem"]["DRAM"] = YAML::Clone(config["MemorySystem"]["DRAM"]);
+    system_config["MemorySystem"]["AddrMapper"] = YAML::Clone(candidate_config);
+
+    auto system = dynamic_cast<MapSearchSystem*>(Factory::create_memory_system(system_config));
+    system->connect_frontend(nullptr);
+
+    Candidate& candidate = candidates.emplace_back();
+    candidate.name = candidate_config["name"].as<std::string>(
+      fmt::format("{}_{}", candidates.size() - 1, candidate_config["impl"].as<std::string>())
+    );
+    candidate.system = system;
+    candidate.mapper = system->m_addr_mapper;
+    candidate.setup();
+  }
+  if (candidates.empty()) {
+    spdlog::error("No candidate address mappers given in MapSearch!");
+    std::exit(1);
+  }
+
+  std::ifstream trace(trace_path);
+  if (!trace.is_open()) {
+    spdlog::error("Trace {} does not exist!", trace_path);
+    std::exit(1);
+  }
+
+  // Stream the trace once: the main thread reads a batch, then the workers map it with their candidates
+  num_threads = std::clamp<int>(num_threads, 1, candidates.size());
+  std::vector<TraceEntry> batch;
+  batch.reserve(batch_size);
+  bool done = false;
+  std::barrier sync(num_threads + 1);
+
+  std::vector<std::thread> workers;
+  for (int tid = 0; tid < num_threads; tid++) {
+    workers.emplace_back([&, tid]() {
+      while (true) {
+        sync.arrive_and_wait();
+        if (done) {
+          return;
+        }
+        for (size_t i = tid; i < candidates.size(); i += num_threads) {
+          candidates[i].process(batch);
+        }
+        sync.arrive_and_wait();
+      }
+    });
+  }
+
+  while (true) {
+    read_batch(trace, batch_size, batch);
+    done = batch.empty();
+    sync.arrive_and_wait();
+    if (done) {
+      break;
+    }
+    sync.arrive_and_wait();
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  // Report the candidates
+  YAML::Emitter emitter;
+  emitter << YAML::BeginMap;
+  for (const auto& candidate : candidates) {
+    auto [channel_max_mean, channel_cov] = balance(candidate.channel_accesses);
+    auto [bank_max_mean, bank_cov] = balance(candidate.bank_accesses);
+    double num_accesses = std::max<size_t>(candidate.num_accesses, 1);
+
+    emitter << YAML::Key << candidate.name;
+    emitter << YAML::Value << YAML::BeginMap;
+    emitter << YAML::Key << "num_accesses" << YAML::Value << candidate.num_accesses;
+    emitter << YAML::Key << "channel_max_to_mean" << YAML::Value << channel_max_mean;
+    emitter << YAML::Key << "channel_cov" << YAML::Value << channel_cov;
+    emitter << YAML::Key << "bank_max_to_mean" << YAML::Value << bank_max_mean;
+    emitter << YAML::Key << "bank_cov" << YAML::Value << bank_cov;
+    emitter << YAML::Key << "row_hit_rate" << YAML::Value << candidate.row_hits / num_accesses;
+    emitter << YAML::Key << "row_miss_rate" << YAML::Value << candidate.row_misses / num_accesses;
+    emitter << YAML::Key << "row_conflict_rate" << YAML::Value << candidate.row_conflicts / num_accesses;
+    emitter << YAML::EndMap;
+  }
+  emitter << YAML::EndMap;
+  std::cout << emitter.c_str() << std::endl;
+
+  return 0;
+}
@@ -2,6 +2,7 @@
 #include <unordered_set>
 #include <vector>
 #include <random>
+#include <limits>
 
 #include "base/base.h"
 #include "translation/translation.h"
@@ -13,24 +14,54 @@ namespace Ramulator {
 class RandomTranslation : public ITranslation, public Implementation {
   RAMULATOR_REGISTER_IMPLEMENTATION(ITranslation, RandomTranslation, "RandomTranslation", "Randomly allocate physical pages to virtual pages.");
 
-  IFrontEnd* m_frontend;
-
   protected:
+    /**
+     * @brief    A set of page numbers from which a uniformly random one is taken in O(1) (by swapping it with the last one)
+     * @details
+     * The page numbers are stored in 32 bits to halve the footprint of the lists (which hold every page of the memory).
+     */
+    struct FreeList {
+      std::vector<uint32_t> pages;
+
+      bool empty() const { return pages.empty(); };
+
+      void push(Addr_t page) { pages.push_back(page); };
+
+      Addr_t pop_random(std::mt19937_64& rng) {
+        size_t idx = rng() % pages.size();
+        Addr_t page = pages[idx];
+        pages[idx] = pages.back();
+        pages.pop_back();
+        return page;
+      };
+    };
+
     std::mt19937_64 m_allocator_rng;
 
     Addr_t m_max_paddr;         // Max physical address
     Addr_t m_pagesize;          // Page size in bytes
     int    m_offsetbits;        // The number of bits for the page offset
-    size_t m_num_pages;         // The total number of physical pages 
+    size_t m_num_pages;         // The total number of physical pages (in whole frames)
 
-    std::vector<bool> m_free_physical_pages;   // The set of remaining pages.
-    size_t m_num_free_physical_pages;
+    // Huge pages (disabled if m_huge_pagesize is 0)
+    Addr_t m_huge_pagesize;     // Huge page size in bytes
+    int    m_huge_offsetbits;   // The number of bits for the huge page offset
+    float  m_huge_page_ratio;   // The probability that a huge virtual page gets a huge physical page
+    size_t m_pages_per_frame;   // The number of pages in a frame (i.e., a huge page, or a page if huge pages are disabled)
 
-    using Translation_t = std::vector<std::unordered_map<Addr_t, Addr_t>>;
-    Translation_t m_translation;    // A vector of <vpn:ppn> maps, each core has its own map
+    FreeList m_free_frames;     // Frames not used yet
+    FreeList m_free_pages;      // Pages of the frames that are split into pages
+    std::unordered_set<Addr_t> m_reserved_pages;    // The set of reserved pages
+    std::unordered_set<Addr_t> m_reserved_frames;   // The set of frames with reserved pages (cannot be huge pages)
+    std::unordered_set<Addr_t> m_huge_frames;       // The set of frames allocated as huge pages
 
-    std::unordered_set<Addr_t> m_reserved_pages;   // A vector of reserved pages
+    using Translation_t = std::vector<std::unordered_map<Addr_t, Addr_t>>;
+    Translation_t m_translation;        // A vector of <vpn:ppn> maps, each core has its own map
+    Translation_t m_huge_translation;   // A vector of <huge vpn:frame number (-1 if mapped with pages)> maps
 
+    size_t s_num_allocated_pages = 0;
+    size_t s_num_allocated_huge_pages = 0;
+    size_t s_num_swapped_pages = 0;
 
   public:
     void init() override {
@@ -41,68 +72,202 @@ class RandomTranslation : public ITranslation, public Implementation {
       m_pagesize    = param<Addr_t>("pagesize_KB").desc("Pagesize in KB.").default_val(4) << 10;
       m_offsetbits  = calc_log2(m_pagesize);
 
-      // Initially, all physical pages are free
-      m_num_pages = m_max_paddr / m_pagesize;
-      m_free_physical_pages.resize(m_num_pages, true);
-      m_num_free_physical_pages = m_num_pages;
+      m_huge_pagesize   = param<Addr_t>("huge_pagesize_KB").desc("Huge page size in KB (e.g., 2048 or 1048576). 0 disables huge pages.").default_val(0) << 10;
+      m_huge_page_ratio = param<float>("huge_page_ratio").desc("The fraction of huge virtual pages backed by a huge physical page (the rest use pages).").default_val(1.0f);
+
+      if (m_pagesize == 0 || (m_pagesize & (m_pagesize - 1)) != 0) {
+        throw ConfigurationError("[RandomTranslation] The page size ({} B) must be a power of two!", m_pagesize);
+      }
+      if (m_huge_pagesize == 0) {
+        m_huge_offsetbits = m_offsetbits;
+      } else {
+        if ((m_huge_pagesize & (m_huge_pagesize - 1)) != 0 || m_huge_pagesize <= m_pagesize) {
+          throw ConfigurationError("[RandomTranslation] The huge page size ({} B) must be a power of two larger than the page size!", m_huge_pagesize);
+        }
+        if (m_huge_page_ratio < 0.0f || m_huge_page_ratio > 1.0f) {
+          throw ConfigurationError("[RandomTranslation] The huge page ratio ({}) must be in [0, 1]!", m_huge_page_ratio);
+        }
+        m_huge_offsetbits = calc_log2(m_huge_pagesize);
+      }
+      m_pages_per_frame = (Addr_t) 1 << (m_huge_offsetbits - m_offsetbits);
 
-      m_frontend = cast_parent<IFrontEnd>();
-      m_translation.resize(m_frontend->get_num_cores());
+      // Initially, all physical frames are free. The pages past the last whole frame are never allocated.
+      size_t num_frames = m_max_paddr / m_pagesize / m_pages_per_frame;
+      m_num_pages = num_frames * m_pages_per_frame;
+      if (num_frames == 0) {
+        throw ConfigurationError("[RandomTranslation] The physical memory ({} B) is smaller than a frame ({} B)!", m_max_paddr, m_pagesize * m_pages_per_frame);
+      }
+      if (m_num_pages > std::numeric_limits<uint32_t>::max()) {
+        throw ConfigurationError("[RandomTranslation] The physical memory ({} B) has more than 2^32 pages!", m_max_paddr);
+      }
+      m_free_frames.pages.resize(num_frames);
+      for (size_t i = 0; i < num_frames; i++) {
+        m_free_frames.pages[i] = i;
+      }
+
+      register_stat(s_num_allocated_pages).name("translation_num_allocated_pages");
+      register_stat(s_num_allocated_huge_pages).name("translation_num_allocated_huge_pages");
+      register_stat(s_num_swapped_pages).name("translation_num_swapped_pages");
 
       m_logger = Logging::create_logger("RandomTranslation");
     };
 
     bool translate(Request& req) override {
+      if (req.source_id < 0) {
+        throw std::runtime_error(fmt::format("[RandomTranslation] Cannot translate a request without a source core (source_id {})!", req.source_id));
+      }
+      if ((size_t) req.source_id >= m_translation.size()) {
+        // The cores are known from their requests as our parent is not necessarily the frontend (e.g., under a TLB)
+        m_translation.resize(req.source_id + 1);
+        m_huge_translation.resize(req.source_id + 1);
+      }
+
+      if (m_huge_pagesize != 0) {
+        Addr_t huge_vpn = req.addr >> m_huge_offsetbits;
+        auto& core_huge_translation = m_huge_translation[req.source_id];
+        auto target = core_huge_translation.find(huge_vpn);
+        if (target == core_huge_translation.end()) {
+          // First access to the huge virtual page. Back it with a huge page if we can.
+          Addr_t frame = -1;
+          if (std::uniform_real_distribution<float>(0.0f, 1.0f)(m_allocator_rng) < m_huge_page_ratio) {
+            frame = allocate_huge_page();
+          }
+          target = core_huge_translation.emplace(huge_vpn, frame).first;
+        }
+
+        if (target->second != (Addr_t) -1) {
+          Addr_t p_addr = (target->second << m_huge_offsetbits) | (req.addr & (m_huge_pagesize - 1));
+          DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, huge VPN {} to Addr {}, frame {}.", req.addr, huge_vpn, p_addr, target->second);
+          req.addr = p_addr;
+          return true;
+        }
+      }
+
       Addr_t vpn = req.addr >> m_offsetbits;
 
       auto& core_translation = m_translation[req.source_id];
       auto target = core_translation.find(vpn);
       if (target == core_translation.end()) {
         // No previous translation record. Assign a new page
-        if (m_num_free_physical_pages == 0) {
+        Addr_t ppn = allocate_page();
+        if (ppn == (Addr_t) -1) {
           // We run out of physical pages. Randomly replace a previously assigned page (swap latency not modeled!)
-          Addr_t ppn_to_replace = m_allocator_rng() % m_num_pages;
+          ppn = m_allocator_rng() % m_num_pages;
           // We do not replace a reserved page
-          while (m_reserved_pages.find(ppn_to_replace) != m_reserved_pages.end()) {
-            ppn_to_replace = m_allocator_rng() % m_num_pages;
+          while (m_reserved_pages.find(ppn) != m_reserved_pages.end()) {
+            ppn = m_allocator_rng() % m_num_pages;
           }
-          core_translation[vpn] = ppn_to_replace;
-          m_logger->warn("Swapping out PPN {} for Addr {}, VPN {}.", ppn_to_replace, req.addr, vpn);
-        } else {
-          // We have available physical pages. Randomly assign one.
-          Addr_t ppn_to_assign = m_allocator_rng() % m_num_pages;
-          // We do not assign a reserved page or an already assigned page
-          while (
-            (m_reserved_pages.find(ppn_to_assign) != m_reserved_pages.end())
-            || (!m_free_physical_pages[ppn_to_assign])
-          ) {
-            ppn_to_assign = m_allocator_rng() % m_num_pages;
-          }
-          core_translation[vpn] = ppn_to_assign;
-          m_num_free_physical_pages--;
+          s_num_swapped_pages++;
+          m_logger->warn("Swapping out PPN {} for Addr {}, VPN {}.", ppn, req.addr, vpn);
         }
-      } 
+        target = core_translation.emplace(vpn, ppn).first;
+      }
 
       // We either found an existing translation or have assigned a new page
-      Addr_t p_addr = (core_translation[vpn] << m_offsetbits) | (req.addr & ((1 << m_offsetbits) - 1));
+      Addr_t p_addr = (target->second << m_offsetbits) | (req.addr & (m_pagesize - 1));
 
-      DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, core_translation[vpn]);
+      DEBUG_LOG(DTRANSLATE, m_logger, "Translated Addr {}, VPN {} to Addr {}, PPN {}.", req.addr, vpn, p_addr, target->second);
 
       req.addr = p_addr;
       return true;
-    };    
+    };
 
     bool reserve(const std::string& type, Addr_t addr) override {
       Addr_t ppn = addr >> m_offsetbits;
-      // Add page to reserved pages if it is not already reserved
+      // A huge page cannot give up one of its pages
+      if (m_huge_frames.find(ppn / m_pages_per_frame) != m_huge_frames.end()) {
+        m_logger->warn("Cannot reserve PPN {} ({}), its frame is already allocated as a huge page.", ppn, type);
+        return false;
+      }
+      // Add page to reserved pages if it is not already reserved.
+      // Free frames and pages are only checked when they are allocated, so reserving is O(1).
       m_reserved_pages.insert(ppn);
-      // std::cout << "Reserved PPN " << ppn << "." << std::endl;
+      m_reserved_frames.insert(ppn / m_pages_per_frame);
       return true;
     };
 
     Addr_t get_max_addr() override {
       return m_max_paddr;
     };
+
+    Addr_t get_pagesize() override {
+      return m_pagesize;
+    };
+
+    Addr_t get_huge_pagesize() override {
+      return m_huge_pagesize;
+    };
+
+    bool is_huge_page(const Request& req) override {
+      if (m_huge_pagesize == 0 || req.source_id < 0 || (size_t) req.source_id >= m_huge_translation.size()) {
+        return false;
+      }
+      const auto& core_huge_translation = m_huge_translation[req.source_id];
+      auto target = core_huge_translation.find(req.addr >> m_huge_offsetbits);
+      return target != core_huge_translation.end() && target->second != (Addr_t) -1;
+    };
+
+  protected:
+    /**
+     * @brief    Returns a random free frame for a huge page, or -1 if there is none
+     * @details
+     * Frames with reserved pages are split into pages instead.
+     */
+    Addr_t allocate_huge_page() {
+      while (!m_free_frames.empty()) {
+        Addr_t frame = m_free_frames.pop_random(m_allocator_rng);
+        if (m_reserved_frames.find(frame) == m_reserved_frames.end()) {
+          m_huge_frames.insert(frame);
+          s_num_allocated_huge_pages++;
+          return frame;
+        }
+        split_frame(frame);
+      }
+      return -1;
+    };
+
+    /**
+     * @brief    Returns a random free page, or -1 if there is none
+     * @details
+     * Without huge pages, frames are pages and are directly taken from the free frames. With huge pages, pages are taken
+     * from the frames that have been split into pages, and a random free frame is split when they run out.
+     */
+    Addr_t allocate_page() {
+      while (true) {
+        if (m_pages_per_frame == 1) {
+          if (m_free_frames.empty()) {
+            return -1;
+          }
+          Addr_t ppn = m_free_frames.pop_random(m_allocator_rng);
+          // We do not assign a reserved page
+          if (m_reserved_pages.find(ppn) == m_reserved_pages.end()) {
+            s_num_allocated_pages++;
+            return ppn;
+          }
+        } else {
+          if (m_free_pages.empty()) {
+            if (m_free_frames.empty()) {
+              return -1;
+            }
+            split_frame(m_free_frames.pop_random(m_allocator_rng));
+            continue;
+          }
+          Addr_t ppn = m_free_pages.pop_random(m_allocator_rng);
+          if (m_reserved_pages.find(ppn) == m_reserved_pages.end()) {
+            s_num_allocated_pages++;
+            return ppn;
+          }
+        }
+      }
+    };
+
+    void split_frame(Addr_t frame) {
+      for (Addr_t ppn = frame * (Addr_t) m_pages_per_frame; ppn < (frame + 1) * (Addr_t) m_pages_per_frame; ppn++) {
+        if (m_reserved_pages.find(ppn) == m_reserved_pages.end()) {
+          m_free_pages.push(ppn);
+        }
+      }
+    };
 };
 
-}   // namespace Ramulator
\ No newline at end of file
+}   // namespace Ramulator
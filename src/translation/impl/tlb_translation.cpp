@@ -0,0 +1,357 @@
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+
+#include "base/base.h"
+#include "translation/translation.h"
+#include "frontend/frontend.h"
+
+
+namespace Ramulator {
+
+/**
+ * @brief    Models per-core L1 and L2 TLBs and the page table walks on TLB misses.
+ * @details
+ * The physical pages are allocated by the child translation (e.g., RandomTranslation), the TLB only adds the latency
+ * of translating an address. The page table is a radix tree (page_table_levels levels of pages with 8-byte entries)
+ * that lives in physical memory: its pages are allocated on demand from a region at the top of the physical address
+ * space that is reserve()d in the child translation so that no data page is ever mapped there. The page size is the
+ * one of the child translation. A huge page of the child takes a single TLB entry and its walk skips the levels below
+ * its entry (e.g., 3 of the 4 levels for 2 MB huge pages with 4 KB pages).
+ *
+ * An L1 TLB hit is free, an L2 TLB hit takes l2_latency cycles, and an L2 TLB miss walks the page table after the L2
+ * lookup, reading one entry per level through the memory port that the frontend connects (i.e., through its caches
+ * and the memory system). Each core has at most one outstanding translation miss: translate() returns false until it
+ * is resolved. Every other call to translate() is a TLB access, so the cores translate each request once (and only call
+ * translate() again for the request while it returns false).
+ */
+class TLBTranslation : public ITranslation, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(ITranslation, TLBTranslation, "TLB", "L1/L2 TLBs with page table walks through the memory system.");
+
+  private:
+    static constexpr int PTE_SIZE = 8;
+
+    /**
+     * @brief    A set-associative TLB with LRU replacement
+     */
+    struct TLB {
+      int num_sets = 1;
+      int associativity = 1;
+      std::vector<Addr_t> vpns;        // The (huge) VPN in each way (-1 if invalid), num_sets x associativity
+      std::vector<bool> huge;          // Whether each way maps a huge page
+      std::vector<Clk_t> last_use;     // The last cycle each way was accessed
+
+      TLB(int num_entries, int associativity) : associativity(associativity) {
+        num_sets = num_entries / associativity;
+        vpns.resize(num_entries, -1);
+        huge.resize(num_entries, false);
+        last_use.resize(num_entries, 0);
+      };
+
+      bool lookup(Addr_t vpn, bool is_huge, Clk_t clk) {
+        int base = (vpn % num_sets) * associativity;
+        for (int way = base; way < base + associativity; way++) {
+          if (vpns[way] == vpn && huge[way] == is_huge) {
+            last_use[way] = clk;
+            return true;
+          }
+        }
+        return false;
+      };
+
+      void insert(Addr_t vpn, bool is_huge, Clk_t clk) {
+        int base = (vpn % num_sets) * associativity;
+        int victim = base;
+        for (int way = base; way < base + associativity; way++) {
+          if ((vpns[way] == vpn && huge[way] == is_huge) || vpns[way] == -1) {
+            victim = way;
+            break;
+          }
+          if (last_use[way] < last_use[victim]) {
+            victim = way;
+          }
+        }
+        vpns[victim] = vpn;
+        huge[victim] = is_huge;
+        last_use[victim] = clk;
+      };
+    };
+
+    enum class MissStatus {
+      None,     // No outstanding translation miss
+      L2,       // Waiting for the L2 TLB
+      Walk,     // Walking the page table
+      Done,     // The translation is in the L1 TLB, waiting for the core to retry
+    };
+
+    struct CoreState {
+      TLB l1;
+      TLB l2;
+
+      MissStatus status = MissStatus::None;
+      Addr_t vpn = -1;            // The VPN of the outstanding miss
+      bool huge = false;          // Whether the outstanding miss is for a huge page
+      Clk_t ready_clk = 0;        // When the L2 TLB lookup finishes
+      Clk_t walk_start_clk = 0;
+      int walk_level = 0;         // The level of the page table entry to read next
+      int walk_levels = 0;        // The number of levels to walk
+      bool walk_in_flight = false;
+
+      // The physical address of each page table page of this core, per level and indexed by the VPN bits above the level
+      std::vector<std::unordered_map<Addr_t, Addr_t>> page_table_pages;
+
+      CoreState(int l1_entries, int l1_associativity, int l2_entries, int l2_associativity, int num_levels):
+      l1(l1_entries, l1_associativity), l2(l2_entries, l2_associativity), page_table_pages(num_levels) {};
+    };
+
+    ITranslation* m_translation = nullptr;    // Allocates the physical pages
+    std::function<bool(Request&)> m_send;     // Sends the page table walk requests
+
+    Clk_t m_clk = 0;
+
+    Addr_t m_pagesize;
+    int m_offsetbits;
+    Addr_t m_huge_pagesize;        // 0 if the child translation has no huge pages
+    int m_huge_offsetbits;
+    int m_l1_entries, m_l1_associativity;
+    int m_l2_entries, m_l2_associativity;
+    int m_l2_latency;
+
+    int m_num_levels;
+    int m_level_bits;              // The number of VPN bits that index each level of the page table
+    int m_huge_walk_levels;        // The number of levels walked for a huge page
+    Addr_t m_page_table_base;      // The first physical address of the page table region
+    Addr_t m_page_table_end;
+    Addr_t m_next_page_table_page;
+
+    std::vector<CoreState> m_cores;
+
+    size_t s_l1_accesses = 0;
+    size_t s_l1_misses = 0;
+    size_t s_l2_accesses = 0;
+    size_t s_l2_misses = 0;
+    size_t s_num_walks = 0;
+    size_t s_walk_memory_accesses = 0;
+    size_t s_walk_latency = 0;
+    float s_l1_miss_rate = 0;
+    float s_l2_miss_rate = 0;
+    float s_avg_walk_latency = 0;
+
+  public:
+    void init() override {
+      m_l1_entries = param<int>("l1_entries").desc("Number of entries of the L1 TLB of each core.").default_val(64);
+      m_l1_associativity = param<int>("l1_associativity").desc("Set associativity of the L1 TLB.").default_val(4);
+      m_l2_entries = param<int>("l2_entries").desc("Number of entries of the L2 TLB of each core.").default_val(1536);
+      m_l2_associativity = param<int>("l2_associativity").desc("Set associativity of the L2 TLB.").default_val(12);
+      m_l2_latency = param<int>("l2_latency").desc("Latency of an L2 TLB lookup in frontend cycles.").default_val(8);
+      m_num_levels = param<int>("page_table_levels").desc("Number of levels of the radix page table.").default_val(4);
+      Addr_t page_table_size = param<Addr_t>("page_table_size_MB").desc("Size of the physical memory region for the page table in MB.").default_val(16) << 20;
+
+      if (m_l1_entries <= 0 || m_l1_associativity <= 0 || m_l1_entries % m_l1_associativity != 0) {
+        throw ConfigurationError("[TLB] The L1 TLB entries ({}) must be a multiple of its associativity ({})!", m_l1_entries, m_l1_associativity);
+      }
+      if (m_l2_entries <= 0 || m_l2_associativity <= 0 || m_l2_entries % m_l2_associativity != 0) {
+        throw ConfigurationError("[TLB] The L2 TLB entries ({}) must be a multiple of its associativity ({})!", m_l2_entries, m_l2_associativity);
+      }
+      if (m_num_levels <= 0) {
+        throw ConfigurationError("[TLB] The page table needs at least one level!");
+      }
+
+      m_translation = create_child_ifce<ITranslation>();
+
+      // The TLB caches the pages of the child translation
+      m_pagesize = m_translation->get_pagesize();
+      if (m_pagesize < PTE_SIZE || (m_pagesize & (m_pagesize - 1)) != 0) {
+        throw ConfigurationError("[TLB] The page size of the child translation ({} B) must be a power of two of at least {} B!", m_pagesize, PTE_SIZE);
+      }
+      m_offsetbits = calc_log2(m_pagesize);
+      m_level_bits = calc_log2(m_pagesize / PTE_SIZE);
+
+      m_huge_pagesize = m_translation->get_huge_pagesize();
+      m_huge_offsetbits = m_huge_pagesize ? calc_log2(m_huge_pagesize) : m_offsetbits;
+      // A huge page is mapped by the entry of the level that covers it (or the first level if none is large enough)
+      m_huge_walk_levels = std::max(m_num_levels - (m_huge_offsetbits - m_offsetbits) / m_level_bits, 1);
+
+      // Put the page table at the top of the physical memory and keep the child translation from allocating it
+      Addr_t max_addr = m_translation->get_max_addr();
+      if (page_table_size < m_pagesize || page_table_size >= max_addr) {
+        throw ConfigurationError("[TLB] The page table region ({} B) does not fit in the physical memory ({} B)!", page_table_size, max_addr);
+      }
+      m_page_table_base = ((max_addr - page_table_size) >> m_offsetbits) << m_offsetbits;
+      m_page_table_end = m_page_table_base + ((page_table_size >> m_offsetbits) << m_offsetbits);
+      m_next_page_table_page = m_page_table_base;
+      for (Addr_t addr = m_page_table_base; addr < m_page_table_end; addr += m_pagesize) {
+        m_translation->reserve("PageTable", addr);
+      }
+
+      register_stat(s_l1_accesses).name("tlb_l1_accesses");
+      register_stat(s_l1_misses).name("tlb_l1_misses");
+      register_stat(s_l1_miss_rate).name("tlb_l1_miss_rate");
+      register_stat(s_l2_accesses).name("tlb_l2_accesses");
+      register_stat(s_l2_misses).name("tlb_l2_misses");
+      register_stat(s_l2_miss_rate).name("tlb_l2_miss_rate");
+      register_stat(s_num_walks).name("tlb_num_walks");
+      register_stat(s_walk_memory_accesses).name("tlb_walk_memory_accesses");
+      register_stat(s_walk_latency).name("tlb_walk_latency");
+      register_stat(s_avg_walk_latency).name("tlb_avg_walk_latency");
+
+      m_logger = Logging::create_logger("TLB");
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      // The frontend connects the memory port when it creates us, so the walks cannot be sent if it has not by now
+      if (!m_send) {
+        throw ConfigurationError("[TLB] The frontend does not connect a memory port for the page table walks!");
+      }
+    };
+
+    void tick() override {
+      m_clk++;
+
+      for (int core_id = 0; core_id < (int) m_cores.size(); core_id++) {
+        CoreState& core = m_cores[core_id];
+        if (core.status == MissStatus::L2 && m_clk >= core.ready_clk) {
+          core.l1.insert(get_tlb_vpn(core), core.huge, m_clk);
+          core.status = MissStatus::Done;
+        } else if (core.status == MissStatus::Walk && !core.walk_in_flight && m_clk >= core.ready_clk) {
+          Request walk_req(get_pte_addr(core, core.walk_level), Request::Type::Read);
+          walk_req.source_id = core_id;
+          walk_req.m_payload = this;
+          if (m_send(walk_req)) {
+            core.walk_in_flight = true;
+            s_walk_memory_accesses++;
+          }
+        }
+      }
+    };
+
+    bool translate(Request& req) override {
+      if (req.source_id < 0) {
+        throw std::runtime_error(fmt::format("[TLB] Cannot translate a request without a source core (source_id {})!", req.source_id));
+      }
+      while ((size_t) req.source_id >= m_cores.size()) {
+        m_cores.emplace_back(m_l1_entries, m_l1_associativity, m_l2_entries, m_l2_associativity, m_num_levels);
+      }
+      CoreState& core = m_cores[req.source_id];
+      Addr_t vpn = req.addr >> m_offsetbits;
+
+      if (core.status == MissStatus::Done && core.vpn == vpn) {
+        // The retry of a resolved miss
+        core.status = MissStatus::None;
+        return m_translation->translate(req);
+      } else if (core.status == MissStatus::L2 || core.status == MissStatus::Walk) {
+        return false;
+      }
+      core.status = MissStatus::None;
+
+      s_l1_accesses++;
+      if (lookup(core.l1, req.addr, core.huge)) {
+        return m_translation->translate(req);
+      }
+      s_l1_misses++;
+
+      core.vpn = vpn;
+      core.ready_clk = m_clk + m_l2_latency;
+      s_l2_accesses++;
+      if (lookup(core.l2, req.addr, core.huge)) {
+        core.status = MissStatus::L2;
+        return false;
+      }
+      s_l2_misses++;
+
+      // Map the page in the child translation now to know whether the walk ends at a huge page
+      Request mapped_req = req;
+      m_translation->translate(mapped_req);
+      core.huge = m_translation->is_huge_page(req);
+
+      DEBUG_LOG(DTRANSLATE, m_logger, "[Clk={}] Core {} starts a page table walk for VPN {}.", m_clk, req.source_id, vpn);
+      core.status = MissStatus::Walk;
+      core.walk_level = 0;
+      core.walk_levels = core.huge ? m_huge_walk_levels : m_num_levels;
+      core.walk_in_flight = false;
+      core.walk_start_clk = m_clk;
+      s_num_walks++;
+      return false;
+    };
+
+    void connect_memory_port(std::function<bool(Request&)> send) override {
+      m_send = send;
+    };
+
+    bool receive(Request& req) override {
+      if (req.m_payload != this) {
+        return false;
+      }
+
+      CoreState& core = m_cores[req.source_id];
+      core.walk_in_flight = false;
+      core.walk_level++;
+      if (core.walk_level == core.walk_levels) {
+        DEBUG_LOG(DTRANSLATE, m_logger, "[Clk={}] Core {} finishes the page table walk for VPN {}.", m_clk, req.source_id, core.vpn);
+        core.l2.insert(get_tlb_vpn(core), core.huge, m_clk);
+        core.l1.insert(get_tlb_vpn(core), core.huge, m_clk);
+        core.status = MissStatus::Done;
+        s_walk_latency += m_clk - core.walk_start_clk;
+      }
+      return true;
+    };
+
+    bool reserve(const std::string& type, Addr_t addr) override {
+      return m_translation->reserve(type, addr);
+    };
+
+    Addr_t get_max_addr() override {
+      return m_translation->get_max_addr();
+    };
+
+    void finalize() override {
+      s_l1_miss_rate = s_l1_accesses ? (float) s_l1_misses / s_l1_accesses : 0;
+      s_l2_miss_rate = s_l2_accesses ? (float) s_l2_misses / s_l2_accesses : 0;
+      s_avg_walk_latency = s_num_walks ? (float) s_walk_latency / s_num_walks : 0;
+    };
+
+  private:
+    /**
+     * @brief    Returns true if the TLB holds the page (or huge page) of vaddr, and sets huge to whether it is a huge page
+     */
+    bool lookup(TLB& tlb, Addr_t vaddr, bool& huge) {
+      if (m_huge_pagesize != 0 && tlb.lookup(vaddr >> m_huge_offsetbits, true, m_clk)) {
+        huge = true;
+        return true;
+      }
+      huge = false;
+      return tlb.lookup(vaddr >> m_offsetbits, false, m_clk);
+    };
+
+    /**
+     * @brief    Returns the VPN (or huge VPN) that the TLB entry of the outstanding miss is tagged with
+     */
+    Addr_t get_tlb_vpn(const CoreState& core) {
+      return core.huge ? core.vpn >> (m_huge_offsetbits - m_offsetbits) : core.vpn;
+    };
+
+    /**
+     * @brief    Returns the physical address of the page table entry that maps the outstanding VPN at the level
+     * @details
+     * The page table page is allocated the first time it is visited.
+     */
+    Addr_t get_pte_addr(CoreState& core, int level) {
+      int shift = m_level_bits * (m_num_levels - 1 - level);
+      Addr_t prefix = core.vpn >> (shift + m_level_bits);
+      Addr_t index = (core.vpn >> shift) & ((1 << m_level_bits) - 1);
+
+      auto& pages = core.page_table_pages[level];
+      auto page = pages.find(prefix);
+      if (page == pages.end()) {
+        if (m_next_page_table_page >= m_page_table_end) {
+          throw ConfigurationError("[TLB] The page table region is full! Increase page_table_size_MB.");
+        }
+        page = pages.emplace(prefix, m_next_page_table_page).first;
+        m_next_page_table_page += m_pagesize;
+      }
+      return page->second + index * PTE_SIZE;
+    };
+};
+
+}   // namespace Ramulator
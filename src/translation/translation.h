@@ -40,6 +40,52 @@ class ITranslation {
       return 0;
     };
 
+    /**
+     * @brief    Returns the page size in bytes (0 if the translation does not allocate pages)
+     * 
+     */
+    virtual Addr_t get_pagesize() {
+      return 0;
+    };
+
+    /**
+     * @brief    Returns the huge page size in bytes (0 if the translation does not allocate huge pages)
+     * 
+     */
+    virtual Addr_t get_huge_pagesize() {
+      return 0;
+    };
+
+    /**
+     * @brief    Returns true if the (already translated) virtual address of req is mapped by a huge page
+     * 
+     */
+    virtual bool is_huge_page(const Request& req) {
+      return false;
+    };
+
+    /**
+     * @brief    Ticks the translation (for translations that model latency, e.g., TLBs and page table walks)
+     * 
+     */
+    virtual void tick() { };
+
+    /**
+     * @brief    Connects the port through which the translation sends its own memory requests (e.g., page table walks)
+     * @details
+     * The frontend delivers the served requests back through receive().
+     * 
+     */
+    virtual void connect_memory_port(std::function<bool(Request&)> send) { };
+
+    /**
+     * @brief    Returns true (and consumes the request) if req is a memory request sent by the translation itself
+     * 
+     */
+    virtual bool receive(Request& req) {
+      return false;
+    };
+
 };
 
 }        // namespace Ramulator